@@ -10,6 +10,7 @@ uniform uvec2 subroutines_index;
 
 uniform sampler2D texture_sampler;
 uniform sampler2D secondary_texture_sampler;
+uniform sampler2DArray flag_atlas_sampler;
 
 vec4 gamma_correct(vec4 colour) {
 	return vec4(pow(colour.rgb, vec3(1.f / gamma)), colour.a);
@@ -131,6 +132,15 @@ vec4 interactable_disabled_color(vec4 color_in) {
 vec4 alt_tint_color(vec4 color_in) {
 	return vec4(color_in.r * subrect.r, color_in.g * subrect.g, color_in.b * subrect.b, color_in.a);
 }
+//layout(index = 20) subroutine(font_function_class)
+vec4 atlas_flag(vec2 tc) {
+	// subrect: x, y = extent of the flag within its layer, z = layer, w = half a texel (keeps filtering inside the flag)
+	return texture(flag_atlas_sampler, vec3(clamp(tc * subrect.xy, vec2(subrect.w), subrect.xy - vec2(subrect.w)), subrect.z));
+}
+//layout(index = 21) subroutine(font_function_class)
+vec4 atlas_flag_mask(vec2 tc) {
+	return vec4(atlas_flag(tc).rgb, texture(secondary_texture_sampler, tc).a);
+}
 
 vec4 font_function(vec2 tc) {
 	switch(int(subroutines_index.y)) {
@@ -148,6 +158,8 @@ case 15: return subsprite_b(tc);
 case 17: return linegraph_color(tc);
 case 18: return transparent_color(tc);
 case 19: return solid_color(tc);
+case 20: return atlas_flag(tc);
+case 21: return atlas_flag_mask(tc);
 default: break;
 	}
 	return vec4(0.f, 0.f, 1.f, 1.f);
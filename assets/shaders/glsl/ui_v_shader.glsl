@@ -1,5 +1,7 @@
 layout (location = 0) in vec2 vertex_position; //0
 layout (location = 1) in vec2 v_tex_coord; //1
+layout (location = 2) in vec4 instance_rect; //2, per instance d_rect when drawing instanced
+layout (location = 3) in vec2 instance_cell; //3, per instance offset into an 8x8 glyph page when drawing instanced
 out vec2 tex_coord;
 
 uniform float screen_width;
@@ -10,13 +12,16 @@ uniform float screen_height;
 // d_rect.z - width
 // d_rect.w - height
 uniform vec4 d_rect;
+// when non-zero, d_rect and the texture coordinates come from the instance attributes instead
+uniform uint instanced;
 
 void main() {
 	// Transform the d_rect rectangle to screen space coordinates
 	// vertex_position is used to flip and/or rotate the coordinates
+	vec4 rect = instanced != 0u ? instance_rect : d_rect;
 	gl_Position = vec4(
-		-1.0 + (2.0 * ((vertex_position.x * d_rect.z)  + d_rect.x) / screen_width),
-		 1.0 - (2.0 * ((vertex_position.y * d_rect.w)  + d_rect.y) / screen_height),
+		-1.0 + (2.0 * ((vertex_position.x * rect.z)  + rect.x) / screen_width),
+		 1.0 - (2.0 * ((vertex_position.y * rect.w)  + rect.y) / screen_height),
 		0.0, 1.0);
-	tex_coord = v_tex_coord;
+	tex_coord = instanced != 0u ? instance_cell + v_tex_coord / 8.0 : v_tex_coord;
 }
@@ -779,6 +779,16 @@ void identify_focuses(sys::state& state) {
 	}
 }
 
+void update_cached_values(sys::state& state) {
+	if(!state.ai_cached_values_out_of_date)
+		return;
+
+	state.ai_cached_values_out_of_date = false;
+
+	identify_focuses(state);
+	initialize_ai_tech_weights(state);
+}
+
 void update_focuses(sys::state& state) {
 	for(auto si : state.world.in_state_instance) {
 		if(!si.get_nation_from_state_ownership().get_is_player_controlled())
@@ -913,6 +923,10 @@ void update_focuses(sys::state& state) {
 }
 
 void take_ai_decisions(sys::state& state) {
+	// potential and allow come from the availability bits computed earlier today; they are only re-checked once an effect
+	// has run, since until then nothing can have changed them
+	bool effects_executed = false;
+
 	for(auto d : state.world.in_decision) {
 		auto e = d.get_effect();
 		if(!e)
@@ -923,47 +937,52 @@ void take_ai_decisions(sys::state& state) {
 		auto ai_will_do = d.get_ai_will_do();
 
 		ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
-			ve::vbitfield_type filter_a = potential
-				? (ve::compress_mask(trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0)) & !state.world.nation_get_is_player_controlled(ids))
-				: !state.world.nation_get_is_player_controlled(ids);
-
-			if(filter_a.v != 0) {
-				// empty allow assumed to be an "always = yes"
-				ve::mask_vector filter_c = allow
-					? (trigger::evaluate(state, allow, trigger::to_generic(ids), trigger::to_generic(ids), 0) && (state.world.nation_get_owned_province_count(ids) != 0)) && filter_a
-					: ve::mask_vector{ filter_a } && (state.world.nation_get_owned_province_count(ids) != 0);
+			ve::mask_vector filter_c = state.world.nation_get_allowed_decisions(ids, d.id)
+				&& !state.world.nation_get_is_player_controlled(ids)
+				&& (state.world.nation_get_owned_province_count(ids) != 0);
+
+			if(ve::compress_mask(filter_c).v != 0) {
 				ve::mask_vector filter_b = ai_will_do
 					? filter_c && (trigger::evaluate_multiplicative_modifier(state, ai_will_do, trigger::to_generic(ids), trigger::to_generic(ids), 0) > 0.0f)
 					: filter_c;
 
 				ve::apply([&](dcon::nation_id n, bool passed_filter) {
 					if(passed_filter) {
-						auto second_validity = potential
-							? trigger::evaluate(state, potential, trigger::to_generic(n), trigger::to_generic(n), 0)
-							: true;
-						second_validity = second_validity && (allow
-							? trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0)
-							: true);
+						auto second_validity = true;
+						if(effects_executed) {
+							second_validity = potential
+								? trigger::evaluate(state, potential, trigger::to_generic(n), trigger::to_generic(n), 0)
+								: true;
+							second_validity = second_validity && (allow
+								? trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0)
+								: true);
+						}
 						if(second_validity) {
 							effect::execute(state, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(state.current_date.value),
 								uint32_t(n.index() << 4 ^ d.id.index()));
-							notification::post(state, notification::message{
-								[e, n, did = d.id, when = state.current_date](sys::state& state, text::layout_base& contents) {
-									text::add_line(state, contents, "msg_decision_1", text::variable_type::x, n, text::variable_type::y, state.world.decision_get_name(did));
-									text::add_line(state, contents, "msg_decision_2");
-									ui::effect_description(state, contents, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(when.value), uint32_t(n.index() << 4 ^ did.index()));
-								},
-								"msg_decision_title",
-								n, dcon::nation_id{}, dcon::nation_id{},
-								sys::message_base_type::decision
-							});
+							effects_executed = true;
+							if(notification::wanted(state, sys::message_base_type::decision, n)) {
+								notification::post(state, notification::message{
+									[e, n, did = d.id, when = state.current_date](sys::state& state, text::layout_base& contents) {
+										text::add_line(state, contents, "msg_decision_1", text::variable_type::x, n, text::variable_type::y, state.world.decision_get_name(did));
+										text::add_line(state, contents, "msg_decision_2");
+										ui::effect_description(state, contents, e, trigger::to_generic(n), trigger::to_generic(n), 0, uint32_t(when.value), uint32_t(n.index() << 4 ^ did.index()));
+									},
+									"msg_decision_title",
+									n, dcon::nation_id{}, dcon::nation_id{},
+									sys::message_base_type::decision
+								});
+							}
 						}
 					}
 				}, ids, filter_b);
 			}
 		});
 	}
-	
+
+	if(effects_executed) {
+		nations::update_decision_availability(state);
+	}
 }
 
 float estimate_pop_party_support(sys::state& state, dcon::nation_id n, dcon::political_party_id pid) {
@@ -2420,6 +2439,8 @@ void sort_possible_justification_cbs(std::vector<possible_cb>& result, sys::stat
 possible_cb pick_fabrication_type(sys::state& state, dcon::nation_id from, dcon::nation_id target) {
 	static std::vector<possible_cb> possibilities;
 
+	// read only: cb_conditions_satisfied and place_instance_in_result test the same can_use / allowed_* triggers
+	trigger::memo_scope memo{ state };
 	sort_possible_justification_cbs(possibilities, state, from, target);
 	// Uncivilized nations are more aggressive to westernize faster
 	float infamy_limit = state.world.nation_get_is_civilized(from) ? state.defines.badboy_limit / 2.f : state.defines.badboy_limit;
@@ -2676,6 +2697,7 @@ void place_instance_in_result_war(sys::state& state, std::vector<possible_cb>& r
 
 void sort_available_cbs(std::vector<possible_cb>& result, sys::state& state, dcon::nation_id n, dcon::war_id w) {
 	result.clear();
+	trigger::memo_scope memo{ state };
 
 	auto is_attacker = military::get_role(state, w, n) == military::war_role::attacker;
 	for(auto par : state.world.war_get_war_participant(w)) {
@@ -18,6 +18,7 @@ void update_influence_priorities(sys::state& state);
 void perform_influence_actions(sys::state& state);
 void update_focuses(sys::state& state);
 void identify_focuses(sys::state& state);
+void update_cached_values(sys::state& state); // regenerates the ai-only tables after a load, before the first tick
 void take_ai_decisions(sys::state& state);
 void update_ai_ruling_party(sys::state& state);
 void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types);
@@ -362,18 +362,8 @@ void apply_technology(sys::state& state, dcon::nation_id target_nation, dcon::te
 
 	state.world.nation_set_active_technologies(target_nation, t_id, true);
 
-	auto tech_mod = tech_id.get_modifier();
-	if(tech_mod) {
-		auto& tech_nat_values = tech_mod.get_national_values();
-		for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-			if(!(tech_nat_values.offsets[i]))
-				break; // no more modifier values attached to this tech
-
-			auto fixed_offset = tech_nat_values.offsets[i];
-			auto modifier_amount = tech_nat_values.values[i];
-
-			state.world.nation_get_modifier_values(target_nation, fixed_offset) += modifier_amount;
-		}
+	if(auto tech_mod = tech_id.get_modifier(); tech_mod) {
+		sys::apply_modifier_delta_to_nation(state, target_nation, tech_mod, 1.0f);
 	}
 
 	auto& plur = state.world.nation_get_plurality(target_nation);
@@ -432,18 +422,8 @@ void remove_technology(sys::state& state, dcon::nation_id target_nation, dcon::t
 
 	state.world.nation_set_active_technologies(target_nation, t_id, false);
 
-	auto tech_mod = tech_id.get_modifier();
-	if(tech_mod) {
-		auto& tech_nat_values = tech_mod.get_national_values();
-		for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-			if(!(tech_nat_values.offsets[i]))
-				break; // no more modifier values attached to this tech
-
-			auto fixed_offset = tech_nat_values.offsets[i];
-			auto modifier_amount = tech_nat_values.values[i];
-
-			state.world.nation_get_modifier_values(target_nation, fixed_offset) -= modifier_amount;
-		}
+	if(auto tech_mod = tech_id.get_modifier(); tech_mod) {
+		sys::apply_modifier_delta_to_nation(state, target_nation, tech_mod, -1.0f);
 	}
 
 	auto& plur = state.world.nation_get_plurality(target_nation);
@@ -503,18 +483,8 @@ void apply_invention(sys::state& state, dcon::nation_id target_nation, dcon::inv
 	state.world.nation_set_active_inventions(target_nation, i_id, true);
 
 	// apply modifiers from active inventions
-	auto inv_mod = inv_id.get_modifier();
-	if(inv_mod) {
-		auto& inv_nat_values = inv_mod.get_national_values();
-		for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-			if(!(inv_nat_values.offsets[i]))
-				break; // no more modifier values attached to this tech
-
-			auto fixed_offset = inv_nat_values.offsets[i];
-			auto modifier_amount = inv_nat_values.values[i];
-
-			state.world.nation_get_modifier_values(target_nation, fixed_offset) += modifier_amount;
-		}
+	if(auto inv_mod = inv_id.get_modifier(); inv_mod) {
+		sys::apply_modifier_delta_to_nation(state, target_nation, inv_mod, 1.0f);
 	}
 
 	for(auto t = economy::province_building_type::railroad; t != economy::province_building_type::last; t = economy::province_building_type(uint8_t(t) + 1)) {
@@ -610,18 +580,8 @@ void remove_invention(sys::state& state, dcon::nation_id target_nation,
 	state.world.nation_set_active_inventions(target_nation, i_id, false);
 
 	// apply modifiers from active inventions
-	auto inv_mod = inv_id.get_modifier();
-	if(inv_mod) {
-		auto& inv_nat_values = inv_mod.get_national_values();
-		for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-			if(!(inv_nat_values.offsets[i]))
-				break; // no more modifier values attached to this tech
-
-			auto fixed_offset = inv_nat_values.offsets[i];
-			auto modifier_amount = inv_nat_values.values[i];
-
-			state.world.nation_get_modifier_values(target_nation, fixed_offset) -= modifier_amount;
-		}
+	if(auto inv_mod = inv_id.get_modifier(); inv_mod) {
+		sys::apply_modifier_delta_to_nation(state, target_nation, inv_mod, -1.0f);
 	}
 
 	for(auto t = economy::province_building_type::railroad; t != economy::province_building_type::last; t = economy::province_building_type(uint8_t(t) + 1)) {
@@ -972,6 +932,18 @@ void update_research(sys::state& state, uint32_t current_year) {
 	}
 }
 
+struct invention_discovery {
+	dcon::nation_id n;
+	dcon::invention_id inv;
+
+	bool operator==(invention_discovery const& other) const noexcept {
+		return other.n == n && other.inv == inv;
+	}
+	bool operator<(invention_discovery const& other) const noexcept {
+		return other.inv != inv ? (inv.value < other.inv.value) : (n.value < other.n.value);
+	}
+};
+
 void discover_inventions(sys::state& state) {
 	/*
 	Inventions have a chance to be discovered on the 1st of every month. The invention chance modifier is computed additively, and
@@ -979,66 +951,63 @@ void discover_inventions(sys::state& state) {
 	discovered, the discoverer gains that amount of shared prestige / the number of times it has been discovered (including the
 	current time).
 	*/
-	for(auto inv : state.world.in_invention) {
-		auto lim = inv.get_limit();
-		auto odds = inv.get_chance();
-		if(lim) {
-			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
-				auto may_discover = !state.world.nation_get_active_inventions(nids, inv)
+
+	// evaluation phase: every invention is tested against the state at the start of the update, so this can run in parallel
+	concurrency::combinable<std::vector<invention_discovery>> discoveries;
+
+	concurrency::parallel_for(uint32_t(0), state.world.invention_size(), [&](uint32_t i) {
+		dcon::invention_id inv{ dcon::invention_id::value_base_t(i) };
+		auto lim = state.world.invention_get_limit(inv);
+		auto odds = state.world.invention_get_chance(inv);
+
+		ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
+			auto may_discover = lim
+				? !state.world.nation_get_active_inventions(nids, inv)
 					&& (state.world.nation_get_owned_province_count(nids) != 0)
-					&& trigger::evaluate(state, lim, trigger::to_generic(nids), trigger::to_generic(nids), 0);
-
-				if(ve::compress_mask(may_discover).v != 0) {
-					auto chances = odds
-						? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
-						: 1.f;
-					ve::apply([&](dcon::nation_id n, float chance, bool allow_discovery) {
-						if(allow_discovery) {
-							auto random = rng::get_random(state, uint32_t(inv.id.index()) << 5 ^ uint32_t(n.index()));
-							if(int32_t(random % 100) < int32_t(chance)) {
-								apply_invention(state, n, inv);
-
-								notification::post(state, notification::message{
-									[inv](sys::state& state, text::layout_base& contents) {
-										text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
-										ui::invention_description(state, contents, inv, 0);
-									},
-									"msg_inv_title",
-									n, dcon::nation_id{}, dcon::nation_id{},
-									sys::message_base_type::invention
-								});
-							}
-						}
-					}, nids, chances, may_discover);
-				}
-			});
-		} else {
-			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto nids) {
-				auto may_not_discover =
-						state.world.nation_get_active_inventions(nids, inv) || (state.world.nation_get_owned_province_count(nids) == 0);
-				if(ve::compress_mask(may_not_discover).v != 0) {
-					auto chances = odds
-						? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
-						: 1.f;
-					ve::apply([&](dcon::nation_id n, float chance, bool block_discovery) {
-						if(!block_discovery) {
-							auto random = rng::get_random(state, uint32_t(inv.id.index()) << 5 ^ uint32_t(n.index()));
-							if(int32_t(random % 100) < int32_t(chance)) {
-								apply_invention(state, n, inv);
-
-								notification::post(state, notification::message{
-									[inv](sys::state& state, text::layout_base& contents) {
-										text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
-										ui::invention_description(state, contents, inv, 0);
-									},
-									"msg_inv_title",
-									n, dcon::nation_id{}, dcon::nation_id{},
-									sys::message_base_type::invention
-								});
-							}
+					&& trigger::evaluate(state, lim, trigger::to_generic(nids), trigger::to_generic(nids), 0)
+				: !state.world.nation_get_active_inventions(nids, inv)
+					&& (state.world.nation_get_owned_province_count(nids) != 0);
+
+			if(ve::compress_mask(may_discover).v != 0) {
+				auto chances = odds
+					? trigger::evaluate_additive_modifier(state, odds, trigger::to_generic(nids), trigger::to_generic(nids), 0)
+					: 1.f;
+				ve::apply([&](dcon::nation_id n, float chance, bool allow_discovery) {
+					if(allow_discovery) {
+						auto random = rng::get_random(state, uint32_t(inv.index()) << 5 ^ uint32_t(n.index()));
+						if(int32_t(random % 100) < int32_t(chance)) {
+							discoveries.local().push_back(invention_discovery{ n, inv });
 						}
-					}, nids, chances, may_not_discover);
-				}
+					}
+				}, nids, chances, may_discover);
+			}
+		});
+	});
+
+	auto total_vector = discoveries.combine([](auto& a, auto& b) {
+		std::vector<invention_discovery> result(a.begin(), a.end());
+		result.insert(result.end(), b.begin(), b.end());
+		return result;
+	});
+
+	// apply phase: serial and in a fixed order so that shared prestige and notifications are deterministic
+	std::sort(total_vector.begin(), total_vector.end());
+	for(auto& d : total_vector) {
+		if(state.world.nation_get_active_inventions(d.n, d.inv))
+			continue;
+
+		apply_invention(state, d.n, d.inv);
+
+		auto inv = d.inv;
+		if(notification::wanted(state, sys::message_base_type::invention, d.n)) {
+			notification::post(state, notification::message{
+				[inv](sys::state& state, text::layout_base& contents) {
+					text::add_line(state, contents, "msg_inv_1", text::variable_type::x, state.world.invention_get_name(inv));
+					ui::invention_description(state, contents, inv, 0);
+				},
+				"msg_inv_title",
+				d.n, dcon::nation_id{}, dcon::nation_id{},
+				sys::message_base_type::invention
 			});
 		}
 	}
@@ -191,128 +191,167 @@ bool movement_is_valid(sys::state& state, dcon::movement_id m) {
 	return false;
 }
 
+enum class movement_membership_change : uint8_t { leave, join_issue, join_independence };
+struct pop_movement_decision {
+	dcon::pop_id p;
+	dcon::issue_option_id option;
+	dcon::national_identity_id independence;
+	movement_membership_change change = movement_membership_change::leave;
+};
+
+// pops are split into a fixed number of contiguous blocks so that the decisions can be committed in pop order
+inline constexpr uint32_t membership_update_blocks = 64;
+
 void update_pop_movement_membership(sys::state& state) {
-	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto owner = nations::owner_of_pop(state, p);
-		// pops not in a nation can't be in a movement
-		if(!owner)
-			return;
+	/*
+	Membership is updated in two passes: first every pop decides, in parallel and without changing anything, whether it leaves
+	or joins a movement. Then the decisions are committed serially, in pop order, which is where movements are created.
+	*/
+	std::vector<pop_movement_decision> decisions[membership_update_blocks];
+	auto const pop_count = state.world.pop_size();
+	auto const block_size = (pop_count + membership_update_blocks - 1) / membership_update_blocks;
+
+	concurrency::parallel_for(uint32_t(0), membership_update_blocks, [&](uint32_t block) {
+		auto& block_decisions = decisions[block];
+		auto const block_end = std::min(pop_count, block_size * (block + 1));
+		for(uint32_t i = block_size * block; i < block_end; ++i) {
+			dcon::pop_id p{ dcon::pop_id::value_base_t(i) };
+
+			auto owner = nations::owner_of_pop(state, p);
+			// pops not in a nation can't be in a movement
+			if(!owner)
+				continue;
 
-		// - Slave pops cannot belong to a movement
-		if(state.world.pop_get_poptype(p) == state.culture_definitions.slaves)
-			return;
-		// pops in rebel factions don't join movements
-		if(state.world.pop_get_rebel_faction_from_pop_rebellion_membership(p))
-			return;
+			// - Slave pops cannot belong to a movement
+			if(state.world.pop_get_poptype(p) == state.culture_definitions.slaves)
+				continue;
+			// pops in rebel factions don't join movements
+			if(state.world.pop_get_rebel_faction_from_pop_rebellion_membership(p))
+				continue;
 
-		auto pop_location = state.world.pop_get_province_from_pop_location(p);
-		// pops in colonial provinces don't join movements
-		if(state.world.province_get_is_colonial(pop_location))
-			return;
+			auto pop_location = state.world.pop_get_province_from_pop_location(p);
+			// pops in colonial provinces don't join movements
+			if(state.world.province_get_is_colonial(pop_location))
+				continue;
 
-		auto existing_movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-		auto mil = pop_demographics::get_militancy(state, p);
+			auto existing_movement = state.world.pop_get_movement_from_pop_movement_membership(p);
+			auto mil = pop_demographics::get_militancy(state, p);
 
-		// -Pops with define : MIL_TO_JOIN_REBEL or greater militancy cannot join a movement
-		if(mil >= state.defines.mil_to_join_rebel) {
-			remove_pop_from_movement(state, p);
-			return;
-		}
-		if(existing_movement) {
-			auto i =
-					state.world.movement_get_associated_issue_option(existing_movement);
-			if(i) {
-				auto support = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, i));
-				if(support * 100.0f < state.defines.issue_movement_leave_limit) {
-					// If the pop's support of the issue for an issue-based movement drops below define:ISSUE_MOVEMENT_LEAVE_LIMIT
-					// the pop will leave the movement.
-					remove_pop_from_movement(state, p);
-					return;
+			// -Pops with define : MIL_TO_JOIN_REBEL or greater militancy cannot join a movement
+			if(mil >= state.defines.mil_to_join_rebel) {
+				if(existing_movement)
+					block_decisions.push_back(pop_movement_decision{ p, dcon::issue_option_id{}, dcon::national_identity_id{}, movement_membership_change::leave });
+				continue;
+			}
+			if(existing_movement) {
+				auto i =
+						state.world.movement_get_associated_issue_option(existing_movement);
+				if(i) {
+					auto support = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, i));
+					if(support * 100.0f < state.defines.issue_movement_leave_limit) {
+						// If the pop's support of the issue for an issue-based movement drops below define:ISSUE_MOVEMENT_LEAVE_LIMIT
+						// the pop will leave the movement.
+						block_decisions.push_back(pop_movement_decision{ p, dcon::issue_option_id{}, dcon::national_identity_id{}, movement_membership_change::leave });
+					}
+				} else if(mil < state.defines.nationalist_movement_mil_cap) {
+					// If the pop's militancy falls below define:NATIONALIST_MOVEMENT_MIL_CAP, the pop will leave an independence
+					// movement.
+					block_decisions.push_back(pop_movement_decision{ p, dcon::issue_option_id{}, dcon::national_identity_id{}, movement_membership_change::leave });
 				}
-			} else if(mil < state.defines.nationalist_movement_mil_cap) {
-				// If the pop's militancy falls below define:NATIONALIST_MOVEMENT_MIL_CAP, the pop will leave an independence
-				// movement.
-				remove_pop_from_movement(state, p);
-				return;
+				// otherwise the pop still remains in movement, no more work to do
+				continue;
 			}
-			// pop still remains in movement, no more work to do
-			return;
-		}
 
-		auto con = pop_demographics::get_consciousness(state, p);
-		auto lit = pop_demographics::get_literacy(state, p);
+			auto con = pop_demographics::get_consciousness(state, p);
+			auto lit = pop_demographics::get_literacy(state, p);
 
-		// a pop with a consciousness of at least 1.5 or a literacy of at least 0.25 may join a movement
-		if(con >= 1.5f || lit >= 0.25f) {
-			/*
-			- If there are one or more issues that the pop supports by at least define:ISSUE_MOVEMENT_JOIN_LIMIT, then the pop has
-			a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy
-			+ issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
-			*/
-			dcon::issue_option_id max_option;
-			float max_support = 0;
-			state.world.for_each_issue_option([&](dcon::issue_option_id io) {
-				auto parent = state.world.issue_option_get_parent_issue(io);
-				auto co = state.world.nation_get_issues(owner, parent);
-				auto allow = state.world.issue_option_get_allow(io);
-				if(co != io && (state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::social) || state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::political))) { // filter out currently active issue
-					auto sup = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, io));
-					if(sup * 100.0f >= state.defines.issue_movement_join_limit && sup > max_support) { // filter out -- above limit thersholds
-						/*
-						then the pop has a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy + issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
-						*/
-
-						// probability test
-						auto fp_prob = 9.0f * sup * (state.defines.movement_lit_factor * lit + state.defines.movement_con_factor * con);
-						auto rvalue = float(uint32_t(rng::get_random(state, (p.value << 3) ^ io.index()) & 0xFFFF)) / float(0x10000);
-						if(rvalue < fp_prob) {
-
-							// is this issue possible to get by law?
-							if(state.world.issue_get_is_next_step_only(parent) == false || co.id.index() + 1 == io.index() || co.id.index() - 1 == io.index()) {
-
-								max_option = io;
-								max_support = sup;
+			// a pop with a consciousness of at least 1.5 or a literacy of at least 0.25 may join a movement
+			if(con >= 1.5f || lit >= 0.25f) {
+				/*
+				- If there are one or more issues that the pop supports by at least define:ISSUE_MOVEMENT_JOIN_LIMIT, then the pop has
+				a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy
+				+ issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
+				*/
+				dcon::issue_option_id max_option;
+				float max_support = 0;
+				state.world.for_each_issue_option([&](dcon::issue_option_id io) {
+					auto parent = state.world.issue_option_get_parent_issue(io);
+					auto co = state.world.nation_get_issues(owner, parent);
+					if(co != io && (state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::social) || state.world.issue_get_issue_type(parent) == uint8_t(culture::issue_type::political))) { // filter out currently active issue
+						auto sup = pop_demographics::get_demo(state, p, pop_demographics::to_key(state, io));
+						if(sup * 100.0f >= state.defines.issue_movement_join_limit && sup > max_support) { // filter out -- above limit thersholds
+							/*
+							then the pop has a chance to join an issue-based movement at probability: issue-support x 9 x define:MOVEMENT_LIT_FACTOR x pop-literacy + issue-support x 9 x define:MOVEMENT_CON_FACTOR x pop-consciousness
+							*/
+
+							// probability test
+							auto fp_prob = 9.0f * sup * (state.defines.movement_lit_factor * lit + state.defines.movement_con_factor * con);
+							auto rvalue = float(uint32_t(rng::get_random(state, (p.value << 3) ^ io.index()) & 0xFFFF)) / float(0x10000);
+							if(rvalue < fp_prob) {
+
+								// is this issue possible to get by law?
+								if(state.world.issue_get_is_next_step_only(parent) == false || co.id.index() + 1 == io.index() || co.id.index() - 1 == io.index()) {
+
+									max_option = io;
+									max_support = sup;
+								}
 							}
 						}
 					}
+				});
+				if(max_option) {
+					block_decisions.push_back(pop_movement_decision{ p, max_option, dcon::national_identity_id{}, movement_membership_change::join_issue });
+				} else if(!state.world.pop_get_is_primary_or_accepted_culture(p) && mil >= state.defines.nationalist_movement_mil_cap) {
+					/*
+					- If there are no valid issues, the pop has a militancy of at least define:NATIONALIST_MOVEMENT_MIL_CAP, does not
+					have the primary culture of the nation it is in, and does have the primary culture of some core in its province,
+					then it has a chance (20% ?) of joining an independence movement for such a core.
+					*/
+					if(rng::reduce(uint32_t(rng::get_random(state, p.value)), 10) != 0) {
+						continue; // exit out of considering this pop
+					}
+					auto pop_culture = state.world.pop_get_culture(p);
+					for(auto c : state.world.province_get_core(pop_location)) {
+						if(c.get_identity().get_primary_culture() == pop_culture) {
+							block_decisions.push_back(pop_movement_decision{ p, dcon::issue_option_id{}, c.get_identity().id, movement_membership_change::join_independence });
+							break;
+						}
+					}
 				}
-			});
-			if(max_option) {
-				if(auto m = get_movement_by_position(state, owner, max_option); m) {
-					add_pop_to_movement(state, p, m);
-				} else if(issue_is_valid_for_movement(state, owner, max_option)) {
+			}
+		}
+	});
+
+	for(auto& block_decisions : decisions) {
+		for(auto& d : block_decisions) {
+			auto owner = nations::owner_of_pop(state, d.p);
+			switch(d.change) {
+			case movement_membership_change::leave:
+				remove_pop_from_movement(state, d.p);
+				break;
+			case movement_membership_change::join_issue:
+				if(auto m = get_movement_by_position(state, owner, d.option); m) {
+					add_pop_to_movement(state, d.p, m);
+				} else if(issue_is_valid_for_movement(state, owner, d.option)) {
 					auto new_movement = fatten(state.world, state.world.create_movement());
-					new_movement.set_associated_issue_option(max_option);
+					new_movement.set_associated_issue_option(d.option);
 					state.world.try_create_movement_within(new_movement, owner);
-					add_pop_to_movement(state, p, new_movement);
+					add_pop_to_movement(state, d.p, new_movement);
 				}
-			} else if(!state.world.pop_get_is_primary_or_accepted_culture(p) && mil >= state.defines.nationalist_movement_mil_cap) {
-				/*
-				- If there are no valid issues, the pop has a militancy of at least define:NATIONALIST_MOVEMENT_MIL_CAP, does not
-				have the primary culture of the nation it is in, and does have the primary culture of some core in its province,
-				then it has a chance (20% ?) of joining an independence movement for such a core.
-				*/
-				if(rng::reduce(uint32_t(rng::get_random(state, p.value)), 10) != 0) {
-					return; // exit out of considering this pop
-				}
-				auto pop_culture = state.world.pop_get_culture(p);
-				for(auto c : state.world.province_get_core(pop_location)) {
-					if(c.get_identity().get_primary_culture() == pop_culture) {
-						auto existing_mov = get_movement_by_independence(state, owner, c.get_identity());
-						if(existing_mov) {
-							state.world.try_create_pop_movement_membership(p, existing_mov);
-						} else {
-							auto new_mov = fatten(state.world, state.world.create_movement());
-							new_mov.set_associated_independence(c.get_identity());
-							state.world.try_create_movement_within(new_mov, owner);
-							state.world.try_create_pop_movement_membership(p, new_mov);
-						}
-						break;
-					}
+				break;
+			case movement_membership_change::join_independence:
+				if(auto existing_mov = get_movement_by_independence(state, owner, d.independence); existing_mov) {
+					state.world.try_create_pop_movement_membership(d.p, existing_mov);
+				} else {
+					auto new_mov = fatten(state.world, state.world.create_movement());
+					new_mov.set_associated_independence(d.independence);
+					state.world.try_create_movement_within(new_mov, owner);
+					state.world.try_create_pop_movement_membership(d.p, new_mov);
 				}
+				break;
 			}
 		}
-	});
+	}
 }
 
 void update_movements(sys::state& state) { // updates cached values and then possibly turns movements into rebels
@@ -441,271 +480,360 @@ bool pop_is_compatible_with_rebel_type(sys::state& state, dcon::pop_id p, dcon::
 	return true;
 }
 
+struct new_faction_description {
+	dcon::rebel_type_id type;
+	dcon::national_identity_id defection_target;
+	dcon::culture_id primary_culture;
+	dcon::culture_group_id primary_culture_group;
+	dcon::religion_id religion;
+
+	bool operator==(new_faction_description const& other) const noexcept {
+		return type == other.type && defection_target == other.defection_target && primary_culture == other.primary_culture
+			&& primary_culture_group == other.primary_culture_group && religion == other.religion;
+	}
+};
+
+// describes the faction of the given type that a pop would found
+new_faction_description describe_new_faction(sys::state& state, dcon::pop_id p, dcon::rebel_type_id rt, dcon::national_identity_id ind_tag) {
+	new_faction_description result;
+	result.type = rt;
+
+	switch(culture::rebel_defection(state.world.rebel_type_get_defection(rt))) {
+	case culture::rebel_defection::culture:
+		result.primary_culture = state.world.pop_get_culture(p);
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_defection::culture_group:
+		result.primary_culture_group = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_defection::religion:
+		result.religion = state.world.pop_get_religion(p);
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_defection::pan_nationalist: {
+		auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+		result.defection_target = state.world.culture_group_get_identity_from_cultural_union_of(cg);
+		break;
+	}
+	case culture::rebel_defection::any:
+		result.defection_target = ind_tag;
+		break;
+	default:
+		break;
+	}
+
+	switch(culture::rebel_independence(state.world.rebel_type_get_independence(rt))) {
+	case culture::rebel_independence::culture:
+		result.primary_culture = state.world.pop_get_culture(p);
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_independence::culture_group:
+		result.primary_culture_group = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_independence::religion:
+		result.religion = state.world.pop_get_religion(p);
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_independence::pan_nationalist: {
+		auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+		result.defection_target = state.world.culture_group_get_identity_from_cultural_union_of(cg);
+		break;
+	}
+	case culture::rebel_independence::any:
+		result.defection_target = ind_tag;
+		break;
+	case culture::rebel_independence::colonial:
+		result.defection_target = ind_tag;
+		break;
+	default:
+		break;
+	}
+
+	if(state.world.rebel_type_get_culture_restriction(rt) && !result.primary_culture) {
+		result.primary_culture = state.world.pop_get_culture(p);
+	}
+	if(state.world.rebel_type_get_culture_group_restriction(rt) && !result.primary_culture_group) {
+		result.primary_culture_group = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+	}
+	return result;
+}
+
+void set_faction_description(sys::state& state, dcon::rebel_faction_id f, new_faction_description const& d) {
+	state.world.rebel_faction_set_type(f, d.type);
+	state.world.rebel_faction_set_defection_target(f, d.defection_target);
+	state.world.rebel_faction_set_primary_culture(f, d.primary_culture);
+	state.world.rebel_faction_set_primary_culture_group(f, d.primary_culture_group);
+	state.world.rebel_faction_set_religion(f, d.religion);
+}
+
+enum class rebel_membership_change : uint8_t { leave, join, create };
+struct pop_rebel_decision {
+	dcon::pop_id p;
+	dcon::rebel_faction_id faction; // the faction to join, for rebel_membership_change::join
+	new_faction_description description; // the faction to found, for rebel_membership_change::create
+	rebel_membership_change change = rebel_membership_change::leave;
+};
+
 void update_pop_rebel_membership(sys::state& state) {
-	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto owner = nations::owner_of_pop(state, p);
-		// pops not in a nation can't be in a rebel faction
-		if(!owner)
-			return;
+	/*
+	As with movements, every pop first decides in parallel which faction it belongs to, and the decisions are then committed
+	serially in pop order. Each block of pops gets its own scratch faction, which stands in for a faction that does not exist
+	yet while the spawn chance modifiers are evaluated. Pops that want to found identical factions in the same nation end up
+	in the same one.
+	*/
+	std::vector<pop_rebel_decision> decisions[membership_update_blocks];
+	dcon::rebel_faction_id scratch_factions[membership_update_blocks];
+	for(auto& f : scratch_factions) {
+		f = state.world.create_rebel_faction();
+	}
+
+	auto const pop_count = state.world.pop_size();
+	auto const block_size = (pop_count + membership_update_blocks - 1) / membership_update_blocks;
+
+	concurrency::parallel_for(uint32_t(0), membership_update_blocks, [&](uint32_t block) {
+		auto& block_decisions = decisions[block];
+		auto const temp = scratch_factions[block];
+		auto const block_end = std::min(pop_count, block_size * (block + 1));
+		for(uint32_t i = block_size * block; i < block_end; ++i) {
+			dcon::pop_id p{ dcon::pop_id::value_base_t(i) };
+
+			auto owner = nations::owner_of_pop(state, p);
+			// pops not in a nation can't be in a rebel faction
+			if(!owner)
+				continue;
 
-		auto mil = pop_demographics::get_militancy(state, p);
-		auto existing_faction = state.world.pop_get_rebel_faction_from_pop_rebellion_membership(p);
+			auto mil = pop_demographics::get_militancy(state, p);
+			auto existing_faction = state.world.pop_get_rebel_faction_from_pop_rebellion_membership(p);
 
-		// -Pops with define : MIL_TO_JOIN_REBEL will join a rebel_faction
-		if(mil >= state.defines.mil_to_join_rebel) {
+			// less than: MIL_TO_JOIN_REBEL will join a rebel_faction -- leave faction
+			if(mil < state.defines.mil_to_join_rebel) {
+				if(existing_faction)
+					block_decisions.push_back(pop_rebel_decision{ p, dcon::rebel_faction_id{}, new_faction_description{}, rebel_membership_change::leave });
+				continue;
+			}
+
+			// -Pops with define : MIL_TO_JOIN_REBEL will join a rebel_faction
 			if(existing_faction && !pop_is_compatible_with_rebel_faction(state, p, existing_faction)) {
-				remove_pop_from_rebel_faction(state, p);
-			} else {
-				auto prov = state.world.pop_get_province_from_pop_location(p);
-				/*
-				- A pop in a province sieged or controlled by rebels will join that faction, if the pop is compatible with the
-				faction.
-				*/
+				block_decisions.push_back(pop_rebel_decision{ p, dcon::rebel_faction_id{}, new_faction_description{}, rebel_membership_change::leave });
+				continue;
+			}
 
-				auto occupying_faction = state.world.province_get_rebel_faction_from_province_rebel_control(prov);
-				if(occupying_faction && pop_is_compatible_with_rebel_faction(state, p, occupying_faction)) {
-					assert(!bool(state.world.province_get_nation_from_province_control(prov)));
-					add_pop_to_rebel_faction(state, p, occupying_faction);
-				} else {
-					/*
-					- Otherwise take all the compatible and possible rebel types. Determine the spawn chance for each of them, by
-					taking the *product* of the modifiers. The pop then joins the type with the greatest chance (that's right, it
-					isn't really a *chance* at all). If that type has a defection type, it joins the faction with the national
-					identity most compatible with it and that type (pan-nationalist go to the union tag, everyone else uses the
-					logic I outline below)
-					*/
-					float greatest_chance = 0.0f;
-					dcon::rebel_faction_id f;
-					for(auto rf : state.world.nation_get_rebellion_within(owner)) {
-						if(pop_is_compatible_with_rebel_faction(state, p, rf.get_rebels())) {
-							auto chance = rf.get_rebels().get_type().get_spawn_chance();
-							auto eval = trigger::evaluate_multiplicative_modifier(state, chance, trigger::to_generic(p),
-									trigger::to_generic(owner), trigger::to_generic(rf.get_rebels().id));
-							if(eval > greatest_chance) {
-								f = rf.get_rebels();
-								greatest_chance = eval;
-							}
-						}
-					}
+			auto prov = state.world.pop_get_province_from_pop_location(p);
+			/*
+			- A pop in a province sieged or controlled by rebels will join that faction, if the pop is compatible with the
+			faction.
+			*/
 
-					dcon::rebel_faction_id temp = state.world.create_rebel_faction();
-					dcon::national_identity_id ind_tag = [&]() {
-						auto prov = state.world.pop_get_province_from_pop_location(p);
-						for(auto core : state.world.province_get_core(prov)) {
-							if(!core.get_identity().get_is_not_releasable() && core.get_identity().get_primary_culture() == state.world.pop_get_culture(p))
-								return core.get_identity().id;
-						}
-						return dcon::national_identity_id{};
-					}();
-
-					dcon::rebel_type_id max_type;
-
-					state.world.for_each_rebel_type([&](dcon::rebel_type_id rt) {
-						if(pop_is_compatible_with_rebel_type(state, p, rt)) {
-							state.world.rebel_faction_set_type(temp, rt);
-							state.world.rebel_faction_set_defection_target(temp, dcon::national_identity_id{});
-							state.world.rebel_faction_set_primary_culture(temp, dcon::culture_id{});
-							state.world.rebel_faction_set_primary_culture_group(temp, dcon::culture_group_id{});
-							state.world.rebel_faction_set_religion(temp, dcon::religion_id{});
-
-							switch(culture::rebel_defection(state.world.rebel_type_get_defection(rt))) {
-							case culture::rebel_defection::culture:
-								state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_defection::culture_group:
-								state.world.rebel_faction_set_primary_culture_group(temp,
-										state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_defection::religion:
-								state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_defection::pan_nationalist: {
-								auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
-								auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
-								if(!u)
-									return; // skip -- no pan nationalist possible
-								state.world.rebel_faction_set_defection_target(temp, u);
-								break;
-							}
-							case culture::rebel_defection::any:
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							default:
-								break;
-							}
+			auto occupying_faction = state.world.province_get_rebel_faction_from_province_rebel_control(prov);
+			if(occupying_faction && pop_is_compatible_with_rebel_faction(state, p, occupying_faction)) {
+				assert(!bool(state.world.province_get_nation_from_province_control(prov)));
+				block_decisions.push_back(pop_rebel_decision{ p, occupying_faction, new_faction_description{}, rebel_membership_change::join });
+				continue;
+			}
 
-							switch(culture::rebel_independence(state.world.rebel_type_get_independence(rt))) {
-							case culture::rebel_independence::culture:
-								state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_independence::culture_group:
-								state.world.rebel_faction_set_primary_culture_group(temp,
-										state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_independence::religion:
-								state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_independence::pan_nationalist: {
-								auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
-								auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
-								if(!u)
-									return; // skip -- no pan nationalist possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								state.world.rebel_faction_set_defection_target(temp, u);
-								break;
-							}
-							case culture::rebel_independence::any:
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							case culture::rebel_independence::colonial:
-								state.world.rebel_faction_set_defection_target(temp, ind_tag);
-								if(!ind_tag)
-									return; // skip -- no defection possible
-								if(state.world.pop_get_is_primary_or_accepted_culture(p))
-									return; // skip -- can't defect
-								break;
-							default:
-								break;
-							}
+			/*
+			- Otherwise take all the compatible and possible rebel types. Determine the spawn chance for each of them, by
+			taking the *product* of the modifiers. The pop then joins the type with the greatest chance (that's right, it
+			isn't really a *chance* at all). If that type has a defection type, it joins the faction with the national
+			identity most compatible with it and that type (pan-nationalist go to the union tag, everyone else uses the
+			logic I outline below)
+			*/
+			float greatest_chance = 0.0f;
+			dcon::rebel_faction_id f;
+			for(auto rf : state.world.nation_get_rebellion_within(owner)) {
+				if(pop_is_compatible_with_rebel_faction(state, p, rf.get_rebels())) {
+					auto chance = rf.get_rebels().get_type().get_spawn_chance();
+					auto eval = trigger::evaluate_multiplicative_modifier(state, chance, trigger::to_generic(p),
+							trigger::to_generic(owner), trigger::to_generic(rf.get_rebels().id));
+					if(eval > greatest_chance) {
+						f = rf.get_rebels();
+						greatest_chance = eval;
+					}
+				}
+			}
 
-							auto chance = state.world.rebel_type_get_spawn_chance(rt);
-							auto eval = trigger::evaluate_multiplicative_modifier(state, chance, trigger::to_generic(p),
-									trigger::to_generic(owner), trigger::to_generic(temp));
-							if(eval > greatest_chance) {
-								f = temp;
-								max_type = rt;
-								greatest_chance = eval;
-							}
-						}
-					});
+			dcon::national_identity_id ind_tag = [&]() {
+				for(auto core : state.world.province_get_core(prov)) {
+					if(!core.get_identity().get_is_not_releasable() && core.get_identity().get_primary_culture() == state.world.pop_get_culture(p))
+						return core.get_identity().id;
+				}
+				return dcon::national_identity_id{};
+			}();
 
-					if(f != temp) {
-						state.world.delete_rebel_faction(temp);
-					} else {
-						auto rt = max_type;
-						state.world.rebel_faction_set_type(temp, rt);
-						state.world.rebel_faction_set_defection_target(temp, dcon::national_identity_id{});
-						state.world.rebel_faction_set_primary_culture(temp, dcon::culture_id{});
-						state.world.rebel_faction_set_primary_culture_group(temp, dcon::culture_group_id{});
-						state.world.rebel_faction_set_religion(temp, dcon::religion_id{});
-
-						switch(culture::rebel_defection(state.world.rebel_type_get_defection(rt))) {
-						case culture::rebel_defection::culture:
-							state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_defection::culture_group:
-							state.world.rebel_faction_set_primary_culture_group(temp,
-									state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_defection::religion:
-							state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_defection::pan_nationalist: {
-							auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
-							auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
-							state.world.rebel_faction_set_defection_target(temp, u);
-							break;
-						}
-						case culture::rebel_defection::any:
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						default:
-							break;
-						}
+			dcon::rebel_type_id max_type;
 
-						switch(culture::rebel_independence(state.world.rebel_type_get_independence(rt))) {
-						case culture::rebel_independence::culture:
-							state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_independence::culture_group:
-							state.world.rebel_faction_set_primary_culture_group(temp,
-									state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_independence::religion:
-							state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_independence::pan_nationalist: {
-							auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
-							auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
-							state.world.rebel_faction_set_defection_target(temp, u);
-							break;
-						}
-						case culture::rebel_independence::any:
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						case culture::rebel_independence::colonial:
-							state.world.rebel_faction_set_defection_target(temp, ind_tag);
-							break;
-						default:
-							break;
-						}
+			state.world.for_each_rebel_type([&](dcon::rebel_type_id rt) {
+				if(pop_is_compatible_with_rebel_type(state, p, rt)) {
+					state.world.rebel_faction_set_type(temp, rt);
+					state.world.rebel_faction_set_defection_target(temp, dcon::national_identity_id{});
+					state.world.rebel_faction_set_primary_culture(temp, dcon::culture_id{});
+					state.world.rebel_faction_set_primary_culture_group(temp, dcon::culture_group_id{});
+					state.world.rebel_faction_set_religion(temp, dcon::religion_id{});
 
-						if(state.world.rebel_type_get_culture_restriction(rt) && !state.world.rebel_faction_get_primary_culture(temp)) {
-							state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
-						}
-						if(state.world.rebel_type_get_culture_group_restriction(rt) && !state.world.rebel_faction_get_primary_culture_group(temp)) {
-							state.world.rebel_faction_set_primary_culture_group(temp, state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
-						}
+					switch(culture::rebel_defection(state.world.rebel_type_get_defection(rt))) {
+					case culture::rebel_defection::culture:
+						state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_defection::culture_group:
+						state.world.rebel_faction_set_primary_culture_group(temp,
+								state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_defection::religion:
+						state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_defection::pan_nationalist: {
+						auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+						auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
+						if(!u)
+							return; // skip -- no pan nationalist possible
+						state.world.rebel_faction_set_defection_target(temp, u);
+						break;
+					}
+					case culture::rebel_defection::any:
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					default:
+						break;
+					}
 
-						state.world.try_create_rebellion_within(temp, owner);
+					switch(culture::rebel_independence(state.world.rebel_type_get_independence(rt))) {
+					case culture::rebel_independence::culture:
+						state.world.rebel_faction_set_primary_culture(temp, state.world.pop_get_culture(p));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_independence::culture_group:
+						state.world.rebel_faction_set_primary_culture_group(temp,
+								state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p)));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_independence::religion:
+						state.world.rebel_faction_set_religion(temp, state.world.pop_get_religion(p));
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_independence::pan_nationalist: {
+						auto cg = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
+						auto u = state.world.culture_group_get_identity_from_cultural_union_of(cg);
+						if(!u)
+							return; // skip -- no pan nationalist possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						state.world.rebel_faction_set_defection_target(temp, u);
+						break;
+					}
+					case culture::rebel_independence::any:
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					case culture::rebel_independence::colonial:
+						state.world.rebel_faction_set_defection_target(temp, ind_tag);
+						if(!ind_tag)
+							return; // skip -- no defection possible
+						if(state.world.pop_get_is_primary_or_accepted_culture(p))
+							return; // skip -- can't defect
+						break;
+					default:
+						break;
 					}
 
-					if(greatest_chance > 0) {
-						add_pop_to_rebel_faction(state, p, f);
+					auto chance = state.world.rebel_type_get_spawn_chance(rt);
+					auto eval = trigger::evaluate_multiplicative_modifier(state, chance, trigger::to_generic(p),
+							trigger::to_generic(owner), trigger::to_generic(temp));
+					if(eval > greatest_chance) {
+						f = temp;
+						max_type = rt;
+						greatest_chance = eval;
 					}
 				}
-			}
-		} else { // less than: MIL_TO_JOIN_REBEL will join a rebel_faction -- leave faction
-			if(existing_faction) {
-				remove_pop_from_rebel_faction(state, p);
+			});
+
+			if(greatest_chance > 0) {
+				if(f == temp) {
+					block_decisions.push_back(pop_rebel_decision{ p, dcon::rebel_faction_id{}, describe_new_faction(state, p, max_type, ind_tag), rebel_membership_change::create });
+				} else {
+					block_decisions.push_back(pop_rebel_decision{ p, f, new_faction_description{}, rebel_membership_change::join });
+				}
 			}
 		}
 	});
+
+	// deleting the scratch factions in the reverse order of their creation leaves the ids of every other faction unchanged
+	for(auto i = membership_update_blocks; i-- > 0;) {
+		state.world.delete_rebel_faction(scratch_factions[i]);
+	}
+
+	struct founded_faction {
+		dcon::nation_id within;
+		dcon::rebel_faction_id faction;
+		new_faction_description description;
+	};
+	std::vector<founded_faction> founded;
+
+	for(auto& block_decisions : decisions) {
+		for(auto& d : block_decisions) {
+			switch(d.change) {
+			case rebel_membership_change::leave:
+				remove_pop_from_rebel_faction(state, d.p);
+				break;
+			case rebel_membership_change::join:
+				add_pop_to_rebel_faction(state, d.p, d.faction);
+				break;
+			case rebel_membership_change::create: {
+				auto owner = nations::owner_of_pop(state, d.p);
+				dcon::rebel_faction_id target;
+				for(auto& ff : founded) {
+					if(ff.within == owner && ff.description == d.description) {
+						target = ff.faction;
+						break;
+					}
+				}
+				if(!target) {
+					target = state.world.create_rebel_faction();
+					set_faction_description(state, target, d.description);
+					state.world.try_create_rebellion_within(target, owner);
+					founded.push_back(founded_faction{ owner, target, d.description });
+				}
+				add_pop_to_rebel_faction(state, d.p, target);
+				break;
+			}
+			}
+		}
+	}
 }
 
 void delete_faction(sys::state& state, dcon::rebel_faction_id reb) {
@@ -1873,6 +1873,17 @@ void alt_regenerate_from_pop_data_daily(sys::state& state) {
 void alt_regenerate_from_pop_data_full(sys::state& state) {
 	alt_mt_regenerate_from_pop_data<true>(state);
 }
+void update_alt_demographics(sys::state& state) {
+	if(!state.alt_demographics_out_of_date)
+		return;
+
+	state.alt_demographics_out_of_date = false;
+
+	// both stores are regenerated from the same pops, so a copy gives the same result as alt_regenerate_from_pop_data_full
+	concurrency::parallel_for(uint32_t(0), size(state), [&](uint32_t index) {
+		alt_copy_demographics(state, dcon::demographics_key{ dcon::demographics_key::value_base_t(index) });
+	});
+}
 
 
 void alt_demographics_update_extras(sys::state& state) {
@@ -184,6 +184,8 @@ void regenerate_from_pop_data_daily(sys::state& state);
 void alt_regenerate_from_pop_data_daily(sys::state& state);
 
 void alt_demographics_update_extras(sys::state& state);
+// makes the alt store a copy of the current demographics if it was invalidated by a load
+void update_alt_demographics(sys::state& state);
 
 struct ideology_buffer {
 	tagged_vector<ve::vectorizable_buffer<uint8_t, dcon::pop_id>, dcon::ideology_id> temp_buffers;
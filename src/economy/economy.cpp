@@ -5324,6 +5324,164 @@ void run_private_investment(sys::state& state) {
 	}
 }
 
+/*
+Everything the trade volume update needs to know about a route that does not depend on the traded commodity, stored
+contiguously per route. It is refreshed once per tick, so that the per-commodity kernel only has to gather prices and
+volumes instead of walking markets, states and nations again for every commodity.
+*/
+struct trade_route_kernel_data {
+	ve::vectorizable_buffer<dcon::market_id, dcon::trade_route_id> origin;
+	ve::vectorizable_buffer<dcon::market_id, dcon::trade_route_id> target;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> origin_tariff;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> target_tariff;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> merchant_cut;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> trade_good_loss_mult;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> transport_cost;
+	ve::vectorizable_buffer<float, dcon::trade_route_id> at_war; // 1.f when the two ends are at war, 0.f otherwise
+	uint32_t size = 0;
+	uint32_t reserved = 0;
+
+	trade_route_kernel_data() : origin(0), target(0), origin_tariff(0), target_tariff(0), merchant_cut(0),
+		trade_good_loss_mult(0), transport_cost(0), at_war(0), size(0) { }
+	void update(uint32_t s) {
+		size = s;
+		if(reserved < s) {
+			reserved = s;
+			origin = ve::vectorizable_buffer<dcon::market_id, dcon::trade_route_id>(s);
+			target = ve::vectorizable_buffer<dcon::market_id, dcon::trade_route_id>(s);
+			origin_tariff = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+			target_tariff = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+			merchant_cut = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+			trade_good_loss_mult = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+			transport_cost = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+			at_war = ve::vectorizable_buffer<float, dcon::trade_route_id>(s);
+		}
+	}
+};
+
+void update_trade_route_kernel_data(
+	sys::state& state,
+	trade_route_kernel_data& data,
+	ve::vectorizable_buffer<dcon::province_id, dcon::state_instance_id> const& coastal_capital_buffer,
+	ve::vectorizable_buffer<float, dcon::nation_id> const& tariff_buffer
+) {
+	data.update(state.world.trade_route_size());
+
+	state.world.execute_parallel_over_trade_route([&](auto trade_route) {
+		auto A = ve::apply([&](auto route) {
+			return state.world.trade_route_get_connected_markets(route, 0);
+		}, trade_route);
+
+		auto B = ve::apply([&](auto route) {
+			return state.world.trade_route_get_connected_markets(route, 1);
+		}, trade_route);
+
+		auto s_A = state.world.market_get_zone_from_local_market(A);
+		auto s_B = state.world.market_get_zone_from_local_market(B);
+
+		auto n_A = state.world.state_instance_get_nation_from_state_ownership(s_A);
+		auto n_B = state.world.state_instance_get_nation_from_state_ownership(s_B);
+
+		auto at_war = ve::apply([&](auto n_a, auto n_b) {
+			return military::are_at_war(state, n_a, n_b);
+		}, n_A, n_B);
+
+		auto sphere_A = state.world.nation_get_in_sphere_of(n_A);
+		auto sphere_B = state.world.nation_get_in_sphere_of(n_B);
+
+		auto is_sea_route = state.world.trade_route_get_is_sea_route(trade_route);
+		auto is_land_route = state.world.trade_route_get_is_land_route(trade_route);
+
+		auto port_A = coastal_capital_buffer.get(s_A);
+		auto port_B = coastal_capital_buffer.get(s_B);
+
+		auto is_A_blockaded = state.world.province_get_is_blockaded(port_A);
+		auto is_B_blockaded = state.world.province_get_is_blockaded(port_B);
+
+		is_sea_route = is_sea_route & !is_A_blockaded & !is_B_blockaded;
+
+		auto same_nation = n_A == n_B;
+		auto same_sphere = (n_A == sphere_B) || (n_B == sphere_A) || (sphere_A == sphere_B);
+
+		ve::fp_vector distance = 999999.f;
+		auto land_distance = state.world.trade_route_get_land_distance(trade_route);
+		auto sea_distance = state.world.trade_route_get_sea_distance(trade_route);
+
+		distance = ve::select(is_land_route, ve::min(distance, land_distance), distance);
+		distance = ve::select(is_sea_route, ve::min(distance, sea_distance), distance);
+
+		state.world.trade_route_set_distance(trade_route, distance);
+
+		data.origin.set(trade_route, A);
+		data.target.set(trade_route, B);
+		data.origin_tariff.set(trade_route, ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_A)));
+		data.target_tariff.set(trade_route, ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_B)));
+		data.merchant_cut.set(trade_route, ve::select(same_nation, ve::fp_vector{ 1.001f }, ve::fp_vector{ 1.05f }));
+		data.trade_good_loss_mult.set(trade_route, ve::max(0.f, 1.f - 0.0001f * distance));
+		// todo: transport cost should be variable?
+		data.transport_cost.set(trade_route, distance * 0.05f);
+		data.at_war.set(trade_route, ve::select(at_war, ve::fp_vector{ 1.f }, ve::fp_vector{ 0.f }));
+	});
+}
+
+void update_trade_volume(sys::state& state, trade_route_kernel_data const& data, dcon::commodity_id c) {
+	state.world.execute_serial_over_trade_route([&](auto trade_route) {
+		auto current_volume = state.world.trade_route_get_volume(trade_route, c);
+		auto absolute_volume = ve::abs(current_volume);
+
+		auto A = data.origin.get(trade_route);
+		auto B = data.target.get(trade_route);
+
+		// import and export tariffs are currently the same rate
+		auto tariff_A = data.origin_tariff.get(trade_route);
+		auto tariff_B = data.target_tariff.get(trade_route);
+		auto merchant_cut = data.merchant_cut.get(trade_route);
+		auto trade_good_loss_mult = data.trade_good_loss_mult.get(trade_route);
+		auto transport_cost = data.transport_cost.get(trade_route);
+		auto at_war = data.at_war.get(trade_route) > 0.f;
+
+		// effect of scale
+		// volume reduces transport costs
+		auto effect_of_scale = ve::max(0.1f, 1.f - absolute_volume * 0.0005f);
+
+		auto price_A = ve_price(state, A, c);
+		auto price_B = ve_price(state, B, c);
+
+		auto price_A_export = price_A * (1.f + tariff_A);
+		auto price_B_export = price_B * (1.f + tariff_B);
+
+		auto price_A_import = price_A * (1.f - tariff_A) * trade_good_loss_mult;
+		auto price_B_import = price_B * (1.f - tariff_B) * trade_good_loss_mult;
+
+		auto current_profit_A_to_B = price_B_import - price_A_export * merchant_cut - transport_cost * effect_of_scale;
+		auto current_profit_B_to_A = price_A_import - price_B_export * merchant_cut - transport_cost * effect_of_scale;
+
+		auto none_is_profiable = (current_profit_A_to_B <= 0.f) && (current_profit_B_to_A <= 0.f);
+
+		auto max_change = 0.1f + absolute_volume * 0.1f;
+		auto change = ve::select(current_profit_A_to_B > 0.f, current_profit_A_to_B / price_A_export, 0.f);
+		change = ve::select(current_profit_B_to_A > 0.f, -current_profit_B_to_A / price_B_export, change);
+		change = ve::min(ve::max(change, -max_change), max_change);
+		change = ve::select(none_is_profiable, -current_volume, change);
+		change = ve::select(at_war, -current_volume, change);
+
+		// trade slowly decays to create soft limit on transportation
+		// essentially, regularisation of trade weights
+		ve::fp_vector decay = 0.99f;
+
+		// dirty, embarassing and disgusting hack
+		// to avoid trade generating too much demand
+		// on already expensive goods
+		// but it works well
+		decay = ve::select(current_volume > 0.f, decay * ve::min(1.f, 10000.f / price_A_export), decay * ve::min(1.f, 10000.f / price_B_export));
+		state.world.trade_route_set_volume(trade_route, c, (current_volume + change) * decay);
+
+		ve::apply([&](auto route) {
+			assert(std::isfinite(state.world.trade_route_get_volume(route, c)));
+		}, trade_route);
+	});
+}
+
 void daily_update(sys::state& state, bool presimulation, float presimulation_stage) {
 
 	static const ve::fp_vector zero = ve::fp_vector{ 0.f };
@@ -5453,6 +5611,9 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 		}, ids);
 	});
 
+	static trade_route_kernel_data trade_routes;
+	update_trade_route_kernel_data(state, trade_routes, coastal_capital_buffer, tariff_buffer);
+
 	// update trade volume based on potential profits right at the start
 	// we can't put it between demand and supply generation!
 	concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
@@ -5462,107 +5623,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 			return;
 		}
 
-		state.world.execute_serial_over_trade_route([&](auto trade_route) {
-			auto current_volume = state.world.trade_route_get_volume(trade_route, c);
-			auto A = ve::apply([&](auto route) {
-				return state.world.trade_route_get_connected_markets(route, 0);
-			}, trade_route);
-
-			auto B = ve::apply([&](auto route) {
-				return state.world.trade_route_get_connected_markets(route, 1);
-			}, trade_route);
-
-			auto absolute_volume = ve::abs(current_volume);
-			//auto sat = state.world.market_get_direct_demand_satisfaction(origin, c);
-
-			auto s_A = state.world.market_get_zone_from_local_market(A);
-			auto s_B = state.world.market_get_zone_from_local_market(B);
-
-			auto n_A = state.world.state_instance_get_nation_from_state_ownership(s_A);
-			auto n_B = state.world.state_instance_get_nation_from_state_ownership(s_B);
-
-			auto at_war = ve::apply([&](auto n_a, auto n_b) {
-				return military::are_at_war(state, n_a, n_b);
-			}, n_A, n_B);
-
-			auto sphere_A = state.world.nation_get_in_sphere_of(n_A);
-			auto sphere_B = state.world.nation_get_in_sphere_of(n_B);
-			
-			auto is_A_civ = state.world.nation_get_is_civilized(n_A);
-			auto is_B_civ = state.world.nation_get_is_civilized(n_B);
-
-			auto is_sea_route = state.world.trade_route_get_is_sea_route(trade_route);
-			auto is_land_route = state.world.trade_route_get_is_land_route(trade_route);
-
-			auto port_A = coastal_capital_buffer.get(s_A);
-			auto port_B = coastal_capital_buffer.get(s_B);
-
-			auto is_A_blockaded = state.world.province_get_is_blockaded(port_A);
-			auto is_B_blockaded = state.world.province_get_is_blockaded(port_B);
-
-			is_sea_route = is_sea_route & !is_A_blockaded & !is_B_blockaded;
-
-			auto same_nation = n_A == n_B;
-			auto same_sphere = (n_A == sphere_B) || (n_B == sphere_A) || (sphere_A == sphere_B);
-
-			auto merchant_cut = ve::select(same_nation, ve::fp_vector{ 1.001f }, ve::fp_vector{ 1.05f });
-
-			auto import_tariff_A = ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_A));
-			auto export_tariff_A = ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_A));
-			auto import_tariff_B = ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_B));
-			auto export_tariff_B = ve::select(same_nation || same_sphere, ve::fp_vector{ 0.f }, tariff_buffer.get(n_B));
-
-			ve::fp_vector distance = 999999.f;
-			auto land_distance = state.world.trade_route_get_land_distance(trade_route);
-			auto sea_distance = state.world.trade_route_get_sea_distance(trade_route);
-
-			distance = ve::select(is_land_route, ve::min(distance, land_distance), distance);
-			distance = ve::select(is_sea_route, ve::min(distance, sea_distance), distance);
-
-			state.world.trade_route_set_distance(trade_route, distance);
-
-			auto trade_good_loss_mult = ve::max(0.f, 1.f - 0.0001f * distance);
-
-			// todo: transport cost should be variable?
-			auto transport_cost = distance * 0.05f;
-
-			// effect of scale
-			// volume reduces transport costs
-			auto effect_of_scale = ve::max(0.1f, 1.f - absolute_volume * 0.0005f);
-
-			auto price_A_export = ve_price(state, A, c) * (1.f + export_tariff_A);
-			auto price_B_export = ve_price(state, B, c) * (1.f + export_tariff_B);
-
-			auto price_A_import = ve_price(state, A, c) * (1.f - import_tariff_A) * trade_good_loss_mult;
-			auto price_B_import = ve_price(state, B, c) * (1.f - import_tariff_B) * trade_good_loss_mult;
-
-			auto current_profit_A_to_B = price_B_import - price_A_export * merchant_cut - transport_cost * effect_of_scale;
-			auto current_profit_B_to_A = price_A_import - price_B_export * merchant_cut - transport_cost * effect_of_scale;
-
-			auto none_is_profiable = (current_profit_A_to_B <= 0.f) && (current_profit_B_to_A <= 0.f);
-
-			auto max_change = 0.1f + absolute_volume * 0.1f;
-			auto change = ve::select(current_profit_A_to_B > 0.f, current_profit_A_to_B / price_A_export, 0.f);
-			change = ve::select(current_profit_B_to_A > 0.f, -current_profit_B_to_A / price_B_export, change);
-			change = ve::min(ve::max(change, -max_change), max_change);
-			change = ve::select(none_is_profiable, -current_volume, change);
-			change = ve::select(at_war, -current_volume, change);
-
-			// trade slowly decays to create soft limit on transportation
-			// essentially, regularisation of trade weights
-			ve::fp_vector decay = 0.99f;
-
-			// dirty, embarassing and disgusting hack
-			// to avoid trade generating too much demand
-			// on already expensive goods
-			// but it works well
-			decay = ve::select(current_volume > 0.f, decay * ve::min(1.f, 10000.f / price_A_export), decay * ve::min(1.f, 10000.f / price_B_export));
-			state.world.trade_route_set_volume(trade_route, c, (current_volume + change) * decay);
-
-			ve::apply([&](auto route) {
-				assert(std::isfinite(state.world.trade_route_get_volume(route, c)));
-			}, trade_route);
-		});
+		update_trade_volume(state, trade_routes, c);
 	});
 
 	sanity_check(state);
@@ -5938,7 +5999,21 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 	sanity_check(state);
 
 	// STEP 4 national budget updates
-	for(auto n : state.nations_by_rank) {
+	/*
+	Nations settle their budgets in parallel: everything done here only touches the treasury, loans and markets of the nation
+	itself. The parts of a bankruptcy that reach other nations (the events fired for the great powers, the timed modifiers and
+	the message) are staged per nation and applied afterwards, in rank order.
+	*/
+	std::vector<std::vector<bankruptcy_type>> staged_bankruptcies(state.world.nation_size());
+	auto stage_bankruptcy = [&](dcon::nation_id n) {
+		staged_bankruptcies[n.index()].push_back(get_bankruptcy_type(state, n));
+		reset_bankrupt_nation(state, n);
+	};
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(state.nations_by_rank.size()), [&](uint32_t rank_index) {
+		auto n = state.nations_by_rank[rank_index];
+		if(!n) // nations_by_rank is padded with empty slots past the live nations
+			return;
 		auto cap_prov = state.world.nation_get_capital(n);
 		auto cap_continent = state.world.province_get_continent(cap_prov);
 		auto cap_region = state.world.province_get_connected_region_id(cap_prov);
@@ -5960,7 +6035,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 				auto ip = interest_payment(state, n);
 				// To become bankrupt nation should be unable to cover its interest payments with its actual money or more loans
 				if(sp < ip && state.world.nation_get_local_loan(n) >= max_loan(state, n)) {
-					go_bankrupt(state, n);
+					stage_bankruptcy(n);
 				}
 				if(ip > 0) {
 					sp -= ip;
@@ -5982,7 +6057,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 				auto& sp = state.world.nation_get_stockpiles(n, economy::money);
 
 				if(sp < 0 && sp < -max_loan(state, n)) {
-					go_bankrupt(state, n);
+					stage_bankruptcy(n);
 				}
 			}
 
@@ -6002,7 +6077,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 			}
 			else if (s < 0) {
 				// Nation somehow got into negative bigger than its loans allow
-				go_bankrupt(state, n);
+				stage_bankruptcy(n);
 			}
 			else if(s > 0 && l > 0) {
 				auto change = std::min(s, l);
@@ -6021,6 +6096,15 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 
 			update_national_consumption(state, n, spending_scale, pi_scale);
 		}
+	});
+
+	for(auto n : state.nations_by_rank) {
+		if(!n)
+			continue;
+		for(auto type : staged_bankruptcies[n.index()]) {
+			fire_bankruptcy_events(state, n, type);
+			apply_bankruptcy_penalties(state, n);
+		}
 	}
 
 	sanity_check(state);
@@ -8315,43 +8399,39 @@ dcon::modifier_id get_province_immigrator_modifier(sys::state& state) {
 	return state.economy_definitions.immigrator_modifier;
 }
 
-void go_bankrupt(sys::state& state, dcon::nation_id n) {
-	auto& debt = state.world.nation_get_local_loan(n);
-
-	/*
-	 If a nation cannot pay and the amount it owes is less than define:SMALL_DEBT_LIMIT, the nation it owes money to gets an on_debtor_default_small event (with the nation defaulting in the from slot). Otherwise, the event is pulled from on_debtor_default. The nation then goes bankrupt. It receives the bad_debter modifier for define:BANKRUPCY_EXTERNAL_LOAN_YEARS years (if it goes bankrupt again within this period, creditors receive an on_debtor_default_second event). It receives the in_bankrupcy modifier for define:BANKRUPCY_DURATION days. Its prestige is reduced by a factor of define:BANKRUPCY_FACTOR, and each of its pops has their militancy increase by 2.
-	*/
+bankruptcy_type get_bankruptcy_type(sys::state& state, dcon::nation_id n) {
 	auto existing_br = state.world.nation_get_bankrupt_until(n);
-	if(existing_br && state.current_date < existing_br) {
-		for(auto gn : state.great_nations) {
-			if(gn.nation && gn.nation != n) {
-				event::fire_fixed_event(state, state.national_definitions.on_debtor_default_second, trigger::to_generic(gn.nation), event::slot_type::nation, gn.nation, trigger::to_generic(n), event::slot_type::nation);
-			}
-		}
-	} else if(debt >= -state.defines.small_debt_limit) {
-		for(auto gn : state.great_nations) {
-			if(gn.nation && gn.nation != n) {
-				event::fire_fixed_event(state, state.national_definitions.on_debtor_default_small, trigger::to_generic(gn.nation), event::slot_type::nation, gn.nation, trigger::to_generic(n), event::slot_type::nation);
-			}
-		}
-	} else {
-		for(auto gn : state.great_nations) {
-			if(gn.nation && gn.nation != n) {
-				event::fire_fixed_event(state, state.national_definitions.on_debtor_default, trigger::to_generic(gn.nation), event::slot_type::nation, gn.nation, trigger::to_generic(n), event::slot_type::nation);
-			}
+	if(existing_br && state.current_date < existing_br)
+		return bankruptcy_type::repeated;
+	else if(state.world.nation_get_local_loan(n) >= -state.defines.small_debt_limit)
+		return bankruptcy_type::small_debt;
+	else
+		return bankruptcy_type::large_debt;
+}
+
+void fire_bankruptcy_events(sys::state& state, dcon::nation_id n, bankruptcy_type type) {
+	auto e = type == bankruptcy_type::repeated
+		? state.national_definitions.on_debtor_default_second
+		: (type == bankruptcy_type::small_debt ? state.national_definitions.on_debtor_default_small : state.national_definitions.on_debtor_default);
+	for(auto gn : state.great_nations) {
+		if(gn.nation && gn.nation != n) {
+			event::fire_fixed_event(state, e, trigger::to_generic(gn.nation), event::slot_type::nation, gn.nation, trigger::to_generic(n), event::slot_type::nation);
 		}
 	}
+}
 
+void reset_bankrupt_nation(sys::state& state, dcon::nation_id n) {
 	// RESET MONEY: POTENTIAL MERGE CONFLICT WITH SNEAKBUG'S FUTURE CHANGES
 	state.world.nation_set_stockpiles(n, economy::money, 0.f);
+	state.world.nation_set_local_loan(n, 0.0f);
+	state.world.nation_set_is_debt_spending(n, false);
+	state.world.nation_set_bankrupt_until(n, state.current_date + int32_t(state.defines.bankrupcy_duration * 365));
+}
 
+void apply_bankruptcy_penalties(sys::state& state, dcon::nation_id n) {
 	sys::add_modifier_to_nation(state, n, state.national_definitions.in_bankrupcy, state.current_date + int32_t(state.defines.bankrupcy_duration * 365));
 	sys::add_modifier_to_nation(state, n, state.national_definitions.bad_debter, state.current_date + int32_t(state.defines.bankruptcy_external_loan_years * 365));
 
-	debt = 0.0f;
-	state.world.nation_set_is_debt_spending(n, false);
-	state.world.nation_set_bankrupt_until(n, state.current_date + int32_t(state.defines.bankrupcy_duration * 365));
-
 	notification::post(state, notification::message{
 		[n](sys::state& state, text::layout_base& contents) {
 			text::add_line(state, contents, "msg_bankruptcy_1", text::variable_type::x, n);
@@ -8362,6 +8442,15 @@ void go_bankrupt(sys::state& state, dcon::nation_id n) {
 	});
 }
 
+void go_bankrupt(sys::state& state, dcon::nation_id n) {
+	/*
+	 If a nation cannot pay and the amount it owes is less than define:SMALL_DEBT_LIMIT, the nation it owes money to gets an on_debtor_default_small event (with the nation defaulting in the from slot). Otherwise, the event is pulled from on_debtor_default. The nation then goes bankrupt. It receives the bad_debter modifier for define:BANKRUPCY_EXTERNAL_LOAN_YEARS years (if it goes bankrupt again within this period, creditors receive an on_debtor_default_second event). It receives the in_bankrupcy modifier for define:BANKRUPCY_DURATION days. Its prestige is reduced by a factor of define:BANKRUPCY_FACTOR, and each of its pops has their militancy increase by 2.
+	*/
+	fire_bankruptcy_events(state, n, get_bankruptcy_type(state, n));
+	reset_bankrupt_nation(state, n);
+	apply_bankruptcy_penalties(state, n);
+}
+
 commodity_production_type get_commodity_production_type(sys::state& state, dcon::commodity_id c) {
 	auto commodity = dcon::fatten(state.world, c);
 	if(commodity.get_rgo_amount() > 0 && (commodity.get_artisan_output_amount() > 0 || commodity.get_key_factory()))
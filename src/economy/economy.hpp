@@ -502,6 +502,11 @@ float gdp_adjusted(sys::state& state, dcon::nation_id n);
 float gdp_adjusted(sys::state& state, dcon::market_id n);
 
 void prune_factories(sys::state& state); // get rid of closed factories in full states
+enum class bankruptcy_type : uint8_t { repeated, small_debt, large_debt };
+bankruptcy_type get_bankruptcy_type(sys::state& state, dcon::nation_id n);
+void fire_bankruptcy_events(sys::state& state, dcon::nation_id n, bankruptcy_type type); // reaches the great powers
+void reset_bankrupt_nation(sys::state& state, dcon::nation_id n); // only touches the bankrupt nation
+void apply_bankruptcy_penalties(sys::state& state, dcon::nation_id n); // timed modifiers and the message
 void go_bankrupt(sys::state& state, dcon::nation_id n);
 dcon::modifier_id get_province_selector_modifier(sys::state& state);
 dcon::modifier_id get_province_immigrator_modifier(sys::state& state);
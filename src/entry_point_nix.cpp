@@ -76,6 +76,9 @@ native_string to_hex(uint64_t v) {
 		 	return ret;
 	};
 
+// the manifest last computed by scenario_inputs_changed, so that a rebuild does not hash the files a second time
+std::vector<char> checked_scenario_inputs;
+
 // Original is void make_mod_file(). This function can also be used to create
 // vanilla scenario, though when there are two bookmarks dates, it will also create
 // additional scenario file alongside with the save file for the bookmark.
@@ -84,6 +87,8 @@ void build_scenario_file() {
 	auto path = produce_mod_path();
 	simple_fs::file_system fs_root;
 	simple_fs::restore_state(fs_root, path);
+	// hashed before the build, so that files edited while it runs still count as changed next time
+	auto inputs = sys::make_scenario_input_manifest(fs_root, checked_scenario_inputs);
 	parsers::error_handler err("");
 	auto root = get_root(fs_root);
 	auto common = open_directory(root, NATIVE("common"));
@@ -120,6 +125,7 @@ void build_scenario_file() {
 			++max_scenario_count;
 			selected_scenario_file = base_name + NATIVE("-") + std::to_string(append) + NATIVE(".bin");
 			sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+			sys::write_scenario_input_manifest(selected_scenario_file, inputs);
 			if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 				auto content = view_contents(*of);
 				auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
@@ -152,6 +158,22 @@ void build_scenario_file() {
 	window::emit_error_message("Scenario file had been generated and saved to " + native_string(getenv("HOME")) + "/.local/share/Alice/\n", false);
 }
 
+// A scenario that was built along with an input manifest is rebuilt once any of the files it was built from changes.
+// Scenarios without a manifest are kept as they are, as before
+bool scenario_inputs_changed(native_string const& name) {
+	simple_fs::file_system fs_root;
+	simple_fs::restore_state(fs_root, produce_mod_path());
+	auto previous = sys::read_scenario_input_manifest(name);
+	checked_scenario_inputs = sys::make_scenario_input_manifest(fs_root, previous);
+	auto changed = sys::changed_scenario_inputs(previous.data(), previous.size(), checked_scenario_inputs);
+	if(changed.size() == 1 && changed[0].empty())
+		return false;
+	for(auto& c : changed) {
+		window::emit_error_message("Changed since the scenario was built: " + c + "\n", false);
+	}
+	return !changed.empty();
+}
+
 //The function below would better be implemented in a launcher
 void find_scenario_file() {
 	selected_scenario_file = NATIVE("");
@@ -304,7 +326,10 @@ int main (int argc, char *argv[]) {
 			//Checking the scenario folder
 			find_scenario_file();
 			//If any file fits the criteria, then don't build
-			if (!selected_scenario_file.empty()) {
+			if (!selected_scenario_file.empty() && scenario_inputs_changed(selected_scenario_file)) {
+				window::emit_error_message("The selected mods changed since the scenario was built. Proceeding to rebuild.\nThis process may take a few minutes to finish.\n", false);
+				build_scenario_file();
+			} else if (!selected_scenario_file.empty()) {
 				window::emit_error_message("Selected scenario file: " + NATIVE(selected_scenario_file) + "\n", false);
 			//If no file fits the critertia, then build
 			} else {
@@ -315,7 +340,10 @@ int main (int argc, char *argv[]) {
 	} else {
 		//Falling back to vanilla
 		find_scenario_file();
-		if (!selected_scenario_file.empty()) {
+		if (!selected_scenario_file.empty() && scenario_inputs_changed(selected_scenario_file)) {
+			window::emit_error_message("The game files changed since the scenario was built. Proceeding to rebuild.\nThis process may take a few minutes to finish.\n", false);
+			build_scenario_file();
+		} else if (!selected_scenario_file.empty()) {
 			window::emit_error_message("Selected scenario file: " + NATIVE(selected_scenario_file) + "\n", false);
 		} else {
 			window::emit_error_message("Building the vanilla scenario file. This process may take a few minutes to complete.\n", false);
@@ -323,7 +351,21 @@ int main (int argc, char *argv[]) {
 		}
 	}
 
-	if (sys::try_read_scenario_and_save_file(game_state, selected_scenario_file)) {
+	// the scenario is read and decompressed on a worker thread, so that its progress can be reported while it happens
+	game_state.save_load.start(selected_scenario_file, sys::load_kind::scenario_and_save);
+	int32_t reported_percent = 0;
+	while(!game_state.save_load.done()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		auto percent = int32_t(game_state.save_load.progress.fraction.load(std::memory_order::acquire) * 10.0f) * 10;
+		if(percent > reported_percent) {
+			reported_percent = percent;
+			window::emit_error_message("Loading scenario file: " + std::to_string(percent) + "%\n", false);
+		}
+	}
+	game_state.save_load.finish();
+	bool scenario_loaded = game_state.save_load.prepared && sys::apply_prepared_load(game_state, game_state.save_load.load);
+	game_state.save_load.load = sys::prepared_load{};
+	if (scenario_loaded) {
 			auto msg = "Running scenario file " + simple_fs::native_to_utf8(selected_scenario_file) + "\n";
 			window::emit_error_message(msg, false);
 			game_state.loaded_scenario_file = NATIVE(selected_scenario_file);
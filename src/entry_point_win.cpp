@@ -293,6 +293,7 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPWSTR
 		}
 
 		if(headless) {
+			game_state.headless = true;
 			game_state.actual_game_speed = headless_speed;
 			game_state.ui_pause.store(false, std::memory_order::release);
 			game_scene::switch_scene(game_state, game_scene::scene_id::in_game_basic);
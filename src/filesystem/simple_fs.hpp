@@ -43,6 +43,10 @@ void add_root(file_system& fs, native_string_view root_path);
 // will be added relative to the location that the executable file exists in (but it is stored as an absolute path)
 void add_relative_root(file_system& fs, native_string_view root_path);
 directory get_root(file_system const& fs);
+// walks every root once so that open_file, peek_file and list_files no longer have to probe each root in turn
+// the index is dropped by any change to the roots or ignored paths and must then be built again explicitly
+void build_index(file_system& fs);
+void clear_index(file_system& fs);
 
 // functions for saving and restoring its state
 native_string extract_state(file_system const& fs);
@@ -69,6 +73,11 @@ void append_file(directory const& dir, native_string_view file_name, char const*
 std::optional<file> open_file(unopened_file const& f);
 native_string get_full_name(unopened_file const& f);
 native_string get_file_name(unopened_file const& f);
+struct file_stamp {
+	uint64_t size = 0;
+	int64_t last_write_time = 0; // in the platform's own units; only meaningful for comparing stamps of the same file
+};
+file_stamp get_file_stamp(unopened_file const& f); // without opening the file; all zero if it cannot be queried
 
 // opened file functions
 file_contents view_contents(file const& f);
@@ -117,10 +117,12 @@ std::optional<file> open_file(unopened_file const& f) {
 void reset(file_system& fs) {
 	fs.ordered_roots.clear();
 	fs.ignored_paths.clear();
+	clear_index(fs);
 }
 
 void add_root(file_system& fs, native_string_view root_path) {
 	fs.ordered_roots.emplace_back(root_path);
+	clear_index(fs);
 }
 
 void add_relative_root(file_system& fs, native_string_view root_path) {
@@ -146,6 +148,7 @@ void add_relative_root(file_system& fs, native_string_view root_path) {
 	}
 
 	fs.ordered_roots.push_back(native_string(module_name) + native_string(root_path));
+	clear_index(fs);
 }
 
 directory get_root(file_system const& fs) {
@@ -199,9 +202,126 @@ bool contains_non_ascii(native_char const* str) {
 }
 } // namespace impl
 
+namespace impl {
+// the key a path is indexed under: separators collapsed, with a leading one, and ascii case folded
+// paths that step through "." or ".." are not normalized here and are looked up on disk instead
+std::optional<native_string> index_key(native_string_view relative_path, native_string_view file_name) {
+	native_string result;
+	result.reserve(relative_path.length() + file_name.length() + 1);
+	auto append_segments = [&](native_string_view path) {
+		size_t position = 0;
+		while(position < path.length()) {
+			auto next = path.find(NATIVE('/'), position);
+			if(next == native_string_view::npos)
+				next = path.length();
+			auto segment = path.substr(position, next - position);
+			if(segment == NATIVE(".") || segment == NATIVE(".."))
+				return false;
+			if(!segment.empty()) {
+				result += NATIVE('/');
+				for(auto c : segment)
+					result += (c >= NATIVE('A') && c <= NATIVE('Z')) ? native_char(c - NATIVE('A') + NATIVE('a')) : c;
+			}
+			position = next + 1;
+		}
+		return true;
+	};
+	if(!append_segments(relative_path) || !append_segments(file_name))
+		return std::optional<native_string>{};
+	return result;
+}
+
+} // namespace impl
+
+void build_index(file_system& fs) {
+	clear_index(fs);
+	auto index_directory = [&](auto& self, uint32_t root, native_string const& relative_path, int32_t depth) -> void {
+		native_string const full_path = fs.ordered_roots[root] + relative_path;
+		if(simple_fs::is_ignored_path(fs, full_path + NATIVE("/")))
+			return;
+		DIR* d = opendir(full_path.c_str());
+		if(!d)
+			return;
+
+		std::vector<native_string> subdirectories;
+		std::vector<indexed_file> listed;
+		struct dirent* dir_ent = nullptr;
+		while((dir_ent = readdir(d)) != nullptr) {
+			if(strcmp(dir_ent->d_name, ".") == 0 || strcmp(dir_ent->d_name, "..") == 0)
+				continue;
+
+			native_string const rel_name = relative_path + NATIVE("/") + dir_ent->d_name;
+			bool is_directory = dir_ent->d_type == DT_DIR;
+			bool is_file = dir_ent->d_type == DT_REG;
+			if(dir_ent->d_type == DT_LNK || dir_ent->d_type == DT_UNKNOWN) { // open_file and peek_file follow links
+				struct stat stat_buf;
+				if(stat((full_path + NATIVE("/") + dir_ent->d_name).c_str(), &stat_buf) != -1) {
+					is_directory = S_ISDIR(stat_buf.st_mode);
+					is_file = S_ISREG(stat_buf.st_mode);
+				}
+			}
+
+			if(is_directory) {
+				if(depth < 64) // guards against link cycles
+					subdirectories.push_back(rel_name);
+			} else if(is_file) {
+				auto key = impl::index_key(rel_name, NATIVE(""));
+				if(key && fs.file_index.find(*key) == fs.file_index.end()
+					&& !simple_fs::is_ignored_path(fs, fs.ordered_roots[root] + rel_name)) {
+					fs.file_index.insert_or_assign(std::move(*key), indexed_file{ root, rel_name });
+				}
+				// list_files reports only plain ascii named files
+				if(dir_ent->d_type == DT_REG && !impl::contains_non_ascii(dir_ent->d_name))
+					listed.push_back(indexed_file{ root, rel_name });
+			}
+		}
+		closedir(d);
+
+		if(auto key = impl::index_key(relative_path, NATIVE("")); key) {
+			auto& listing = fs.directory_index[*key];
+			// a name already listed from a later root shadows this one
+			ankerl::unordered_dense::set<native_string> names;
+			for(auto const& e : listing)
+				names.insert(e.relative_path.substr(e.relative_path.rfind(NATIVE('/')) + 1));
+			for(auto& f : listed) {
+				if(names.insert(f.relative_path.substr(relative_path.length() + 1)).second)
+					listing.push_back(std::move(f));
+			}
+		}
+		for(auto const& sub : subdirectories)
+			self(self, root, sub, depth + 1);
+	};
+
+	for(size_t i = fs.ordered_roots.size(); i-- > 0;) {
+		index_directory(index_directory, uint32_t(i), NATIVE(""), 0);
+	}
+	fs.indexed = true;
+}
+
+void clear_index(file_system& fs) {
+	fs.file_index.clear();
+	fs.directory_index.clear();
+	fs.indexed = false;
+}
+
 std::vector<unopened_file> list_files(directory const& dir, native_char const* extension) {
 	std::vector<unopened_file> accumulated_results;
-	if(dir.parent_system) {
+	auto index_key = (dir.parent_system && dir.parent_system->indexed) ? impl::index_key(dir.relative_path, NATIVE("")) : std::optional<native_string>{};
+	if(index_key) {
+		if(auto it = dir.parent_system->directory_index.find(*index_key); it != dir.parent_system->directory_index.end()) {
+			for(auto const& f : it->second) {
+				auto const name = f.relative_path.substr(f.relative_path.rfind(NATIVE('/')) + 1);
+				if(extension && extension[0] != 0) {
+					auto dot = name.rfind(NATIVE('.'));
+					if(dot == native_string::npos || dot == 0)
+						continue;
+					if(strcmp(name.c_str() + dot, extension))
+						continue;
+				}
+				accumulated_results.emplace_back(dir.parent_system->ordered_roots[f.root] + f.relative_path, name);
+			}
+		}
+	} else if(dir.parent_system) {
 		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
 			auto const appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
 			if(simple_fs::is_ignored_path(*dir.parent_system, appended_path + NATIVE("/"))) {
@@ -338,6 +458,18 @@ directory open_directory(directory const& dir, native_string_view directory_name
 }
 
 std::optional<file> open_file(directory const& dir, native_string_view file_name) {
+	auto index_key = (dir.parent_system && dir.parent_system->indexed) ? impl::index_key(dir.relative_path, file_name) : std::optional<native_string>{};
+	if(index_key) {
+		auto it = dir.parent_system->file_index.find(*index_key);
+		if(it == dir.parent_system->file_index.end())
+			return std::optional<file>{};
+		native_string full_path = dir.parent_system->ordered_roots[it->second.root] + it->second.relative_path;
+		int file_descriptor = open(full_path.c_str(), O_RDONLY | O_NONBLOCK);
+		if(file_descriptor != -1) {
+			return std::optional<file>(file(file_descriptor, full_path));
+		}
+		// removed since the index was built: probe the roots as usual
+	}
 	if(dir.parent_system) {
 		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
 			native_string dir_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
@@ -361,6 +493,13 @@ std::optional<file> open_file(directory const& dir, native_string_view file_name
 }
 
 std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name) {
+	auto index_key = (dir.parent_system && dir.parent_system->indexed) ? impl::index_key(dir.relative_path, file_name) : std::optional<native_string>{};
+	if(index_key) {
+		auto it = dir.parent_system->file_index.find(*index_key);
+		if(it == dir.parent_system->file_index.end())
+			return std::optional<unopened_file>{};
+		return std::optional<unopened_file>(unopened_file(dir.parent_system->ordered_roots[it->second.root] + it->second.relative_path, file_name));
+	}
 	if(dir.parent_system) {
 		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
 			native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('/') + native_string(file_name);
@@ -386,6 +525,7 @@ std::optional<unopened_file> peek_file(directory const& dir, native_string_view
 
 void add_ignore_path(file_system& fs, native_string_view replaced_path) {
 	fs.ignored_paths.emplace_back(replaced_path);
+	clear_index(fs);
 }
 
 std::vector<native_string> list_roots(file_system const& fs) {
@@ -408,6 +548,13 @@ native_string get_file_name(unopened_file const& f) {
 	return f.file_name;
 }
 
+file_stamp get_file_stamp(unopened_file const& f) {
+	struct stat info;
+	if(stat(get_full_name(f).c_str(), &info) != 0)
+		return file_stamp{};
+	return file_stamp{ uint64_t(info.st_size), int64_t(info.st_mtim.tv_sec) * 1000000000 + int64_t(info.st_mtim.tv_nsec) };
+}
+
 native_string get_full_name(file const& f) {
 	return f.absolute_path;
 }
@@ -7,10 +7,20 @@
 // all in the namespace simple_fs, all classes
 
 namespace simple_fs {
+struct indexed_file {
+	uint32_t root = 0;           // position in ordered_roots
+	native_string relative_path; // as it is spelled on disk, starting with a separator
+};
+
 class file_system {
 	std::vector<native_string> ordered_roots;
 	std::vector<native_string> ignored_paths;
 
+	// optional index of everything under the roots (see build_index); dropped whenever the roots or the ignored paths change
+	ankerl::unordered_dense::map<native_string, indexed_file> file_index;                     // case folded path -> the file open_file finds
+	ankerl::unordered_dense::map<native_string, std::vector<indexed_file>> directory_index; // case folded path -> what list_files reports
+	bool indexed = false;
+
 	void operator=(file_system const& other) = delete;
 	void operator=(file_system&& other) = delete;
 
@@ -29,6 +39,8 @@ public:
 	friend void add_ignore_path(file_system& fs, native_string_view replaced_path);
 	friend std::vector<native_string> list_roots(file_system const& fs);
 	friend bool is_ignored_path(file_system const& fs, native_string_view path);
+	friend void build_index(file_system& fs);
+	friend void clear_index(file_system& fs);
 };
 
 class directory {
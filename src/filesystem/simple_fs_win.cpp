@@ -335,6 +335,10 @@ bool is_ignored_path(file_system const& fs, native_string_view path) {
 	return false;
 }
 
+// not indexed on windows: lookups keep probing each root
+void build_index(file_system& fs) { }
+void clear_index(file_system& fs) { }
+
 native_string get_full_name(unopened_file const& f) {
 	return f.absolute_path;
 }
@@ -343,6 +347,14 @@ native_string get_file_name(unopened_file const& f) {
 	return f.file_name;
 }
 
+file_stamp get_file_stamp(unopened_file const& f) {
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	if(!GetFileAttributesExW(get_full_name(f).c_str(), GetFileExInfoStandard, &info))
+		return file_stamp{};
+	return file_stamp{ (uint64_t(info.nFileSizeHigh) << 32) | uint64_t(info.nFileSizeLow),
+		int64_t((uint64_t(info.ftLastWriteTime.dwHighDateTime) << 32) | uint64_t(info.ftLastWriteTime.dwLowDateTime)) };
+}
+
 native_string get_full_name(file const& f) {
 	return f.absolute_path;
 }
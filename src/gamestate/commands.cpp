@@ -2061,6 +2061,7 @@ void execute_take_decision(sys::state& state, dcon::nation_id source, dcon::deci
 		effect::execute(state, e, trigger::to_generic(source), trigger::to_generic(source), 0, uint32_t(state.current_date.value),
 				uint32_t(source.index() << 4 ^ d.index()));
 		event::update_future_events(state);
+		nations::update_decision_availability(state, source); // so the decision window does not wait for the next day
 	}
 
 	notification::post(state, notification::message{
@@ -5966,6 +5967,7 @@ void execute_pending_commands(sys::state& state) {
 		province::update_connected_regions(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		state.publish_ui_snapshot(); // commands also run while paused, when no tick would republish it
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
 }
@@ -10,56 +10,6 @@
 
 namespace sys {
 
-// NOTE: these functions do not add or remove a modifier from the list of modifiers for an entity
-void apply_modifier_values_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id) {
-	auto& nat_values = state.world.modifier_get_national_values(mod_id);
-	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-		if(!(nat_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = nat_values.offsets[i];
-		auto modifier_amount = nat_values.values[i];
-		state.world.nation_get_modifier_values(target_nation, fixed_offset) += modifier_amount;
-	}
-}
-
-void apply_scaled_modifier_values_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id,
-		float scale) {
-	auto& nat_values = state.world.modifier_get_national_values(mod_id);
-	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-		if(!(nat_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = nat_values.offsets[i];
-		auto modifier_amount = nat_values.values[i];
-		state.world.nation_get_modifier_values(target_nation, fixed_offset) += modifier_amount * scale;
-	}
-}
-
-void apply_modifier_values_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id) {
-	auto& prov_values = state.world.modifier_get_province_values(mod_id);
-	auto owner = state.world.province_get_nation_from_province_ownership(target_prov);
-	for(uint32_t i = 0; i < sys::provincial_modifier_definition::modifier_definition_size; ++i) {
-		if(!(prov_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = prov_values.offsets[i];
-		auto modifier_amount = prov_values.values[i];
-		state.world.province_get_modifier_values(target_prov, fixed_offset) += modifier_amount;
-	}
-	if(owner) {
-		auto& nat_values = state.world.modifier_get_national_values(mod_id);
-		for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-			if(!(nat_values.offsets[i]))
-				break; // no more modifier values
-
-			auto fixed_offset = nat_values.offsets[i];
-			auto modifier_amount = nat_values.values[i];
-			state.world.nation_get_modifier_values(owner, fixed_offset) += modifier_amount;
-		}
-	}
-}
-
 void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id, sys::date expiration) {
 	auto lst = state.world.nation_get_current_modifiers(target_nation);
 	for(auto& m : lst) {
@@ -71,6 +21,7 @@ void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dc
 		}
 	}
 	lst.push_back(sys::dated_modifier{expiration, mod_id});
+	apply_modifier_delta_to_nation(state, target_nation, mod_id, 1.0f);
 }
 void add_modifier_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, sys::date expiration) {
 	auto lst = state.world.province_get_current_modifiers(target_prov);
@@ -83,6 +34,7 @@ void add_modifier_to_province(sys::state& state, dcon::province_id target_prov,
 		}
 	}
 	lst.push_back(sys::dated_modifier{expiration, mod_id});
+	apply_modifier_delta_to_province(state, target_prov, mod_id, 1.0f);
 }
 void remove_modifier_from_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id) {
 	auto modifiers_range = state.world.nation_get_current_modifiers(target_nation);
@@ -90,6 +42,7 @@ void remove_modifier_from_nation(sys::state& state, dcon::nation_id target_natio
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			apply_modifier_delta_to_nation(state, target_nation, mod_id, -1.0f);
 			return;
 		}
 	}
@@ -101,6 +54,7 @@ void remove_modifier_from_province(sys::state& state, dcon::province_id target_p
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			apply_modifier_delta_to_province(state, target_prov, mod_id, -1.0f);
 			return;
 		}
 	}
@@ -113,393 +67,158 @@ void toggle_modifier_from_province(sys::state& state, dcon::province_id target_p
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			apply_modifier_delta_to_province(state, target_prov, mod_id, -1.0f);
 			return;
 		}
 	}
 	lst.push_back(sys::dated_modifier{ expiration, mod_id });
+	apply_modifier_delta_to_province(state, target_prov, mod_id, 1.0f);
 }
 
-template<typename F>
-void bulk_apply_masked_modifier_to_nations(sys::state& state, dcon::modifier_id m, F const& mask_functor) {
-	auto& nat_values = state.world.modifier_get_national_values(m);
-	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-		if(!(nat_values.offsets[i]))
-			break; // no more modifier values attached
-
-		state.world.execute_serial_over_nation(
-				[&, fixed_offset = nat_values.offsets[i], modifier_amount = nat_values.values[i]](auto nation_indices) {
-					auto has_mod_mask = mask_functor(nation_indices);
-					auto old_mod_value = state.world.nation_get_modifier_values(nation_indices, fixed_offset);
-					state.world.nation_set_modifier_values(nation_indices, fixed_offset,
-							ve::select(has_mod_mask, old_mod_value + modifier_amount, old_mod_value));
-				});
-	}
-}
-
-template<typename F>
-void bulk_apply_scaled_modifier_to_nations(sys::state& state, dcon::modifier_id m, F const& scale_functor) {
-	auto& nat_values = state.world.modifier_get_national_values(m);
-	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-		if(!(nat_values.offsets[i]))
-			break; // no more modifier values attached
-
-		state.world.execute_serial_over_nation(
-				[&, fixed_offset = nat_values.offsets[i], modifier_amount = nat_values.values[i]](auto nation_indices) {
-					auto scaling_factor = scale_functor(nation_indices);
-					auto old_mod_value = state.world.nation_get_modifier_values(nation_indices, fixed_offset);
-					state.world.nation_set_modifier_values(nation_indices, fixed_offset, old_mod_value + scaling_factor * modifier_amount);
-				});
-	}
-}
-
-template<typename F>
-void bulk_apply_masked_modifier_to_provinces(sys::state& state, dcon::modifier_id mod_id, F const& mask_functor) {
-	auto& prov_values = state.world.modifier_get_province_values(mod_id);
-
-	for(uint32_t i = 0; i < sys::provincial_modifier_definition::modifier_definition_size; ++i) {
-		if(!(prov_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = prov_values.offsets[i];
-		auto modifier_amount = prov_values.values[i];
-
-		province::ve_for_each_land_province(state, [&](auto ids) {
-			auto has_mod_mask = mask_functor(ids);
-			auto old_value = state.world.province_get_modifier_values(ids, fixed_offset);
-			state.world.province_set_modifier_values(ids, fixed_offset,
-					ve::select(has_mod_mask, old_value + modifier_amount, old_value));
-		});
-	}
-
+// NOTE: these functions do not add or remove a modifier from the list of modifiers for an entity, nor do they update the
+// modifier ledger; use apply_modifier_delta_to_nation / apply_modifier_delta_to_province for that
+void apply_scaled_modifier_values_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id,
+		float scale) {
 	auto& nat_values = state.world.modifier_get_national_values(mod_id);
-
 	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
 		if(!(nat_values.offsets[i]))
 			break; // no more modifier values
 
 		auto fixed_offset = nat_values.offsets[i];
 		auto modifier_amount = nat_values.values[i];
-
-		province::ve_for_each_land_province(state, [&](auto ids) {
-			auto owners = state.world.province_get_nation_from_province_ownership(ids);
-			auto has_mod_mask = mask_functor(ids) && (owners != dcon::nation_id{});
-
-			auto old_value = state.world.nation_get_modifier_values(owners, fixed_offset);
-			state.world.nation_set_modifier_values(owners, fixed_offset,
-					ve::select(has_mod_mask, old_value + modifier_amount, old_value));
-		});
+		state.world.nation_get_modifier_values(target_nation, fixed_offset) += modifier_amount * scale;
 	}
 }
 
-void bulk_apply_modifier_to_provinces(sys::state& state, dcon::modifier_id mod_id) {
+void apply_scaled_modifier_values_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id,
+		float scale) {
 	auto& prov_values = state.world.modifier_get_province_values(mod_id);
-
 	for(uint32_t i = 0; i < sys::provincial_modifier_definition::modifier_definition_size; ++i) {
 		if(!(prov_values.offsets[i]))
 			break; // no more modifier values
 
 		auto fixed_offset = prov_values.offsets[i];
 		auto modifier_amount = prov_values.values[i];
-
-		province::ve_for_each_land_province(state, [&](auto ids) {
-			auto old_value = state.world.province_get_modifier_values(ids, fixed_offset);
-			state.world.province_set_modifier_values(ids, fixed_offset, old_value + modifier_amount);
-		});
+		state.world.province_get_modifier_values(target_prov, fixed_offset) += modifier_amount * scale;
 	}
 }
 
-template<typename F>
-void bulk_apply_scaled_modifier_to_provinces(sys::state& state, dcon::modifier_id mod_id, F const& scale_functor) {
-	auto& prov_values = state.world.modifier_get_province_values(mod_id);
-
-	for(uint32_t i = 0; i < sys::provincial_modifier_definition::modifier_definition_size; ++i) {
-		if(!(prov_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = prov_values.offsets[i];
-		auto modifier_amount = prov_values.values[i];
-
-		province::ve_for_each_land_province(state, [&](auto ids) {
-			auto scale = scale_functor(ids);
-			auto old_value = state.world.province_get_modifier_values(ids, fixed_offset);
-			state.world.province_set_modifier_values(ids, fixed_offset, old_value + modifier_amount * scale);
-		});
-	}
-
-	auto& nat_values = state.world.modifier_get_national_values(mod_id);
-
-	for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-		if(!(nat_values.offsets[i]))
-			break; // no more modifier values
-
-		auto fixed_offset = nat_values.offsets[i];
-		auto modifier_amount = nat_values.values[i];
+/*
+The modifier ledger records, for every nation and land province, which modifiers are currently folded into its modifier values
+and with what scale. Changes to the sources of modifiers are then applied as the signed difference between the recorded scale
+and the new one, instead of zeroing and rebuilding every value.
+*/
 
-		province::ve_for_each_land_province(state, [&](auto ids) {
-			auto owners = state.world.province_get_nation_from_province_ownership(ids);
-			auto scale = ve::select(owners != dcon::nation_id{}, scale_functor(ids), 0.0f);
+namespace {
 
-			auto old_value = state.world.nation_get_modifier_values(owners, fixed_offset);
-			state.world.nation_set_modifier_values(owners, fixed_offset, old_value + modifier_amount * scale);
-		});
-	}
+bool is_land_province(sys::state const& state, dcon::province_id p) {
+	return p.index() < state.province_definitions.first_sea_province.index();
 }
 
-void recreate_national_modifiers(sys::state& state) {
-
-	// purge expired triggered modifiers
-	for(auto n : state.world.in_nation) {
-		auto timed_modifiers = n.get_current_modifiers();
-		for(uint32_t i = timed_modifiers.size(); i-- > 0;) {
-			if(bool(timed_modifiers[i].expiration) && timed_modifiers[i].expiration < state.current_date) {
-				timed_modifiers.remove_at(i);
-			}
-		}
+void ensure_ledger_size(sys::state& state) {
+	auto& ledger = state.applied_modifiers;
+	if(ledger.nations.size() < state.world.nation_size())
+		ledger.nations.resize(state.world.nation_size());
+	if(ledger.provinces.size() < state.world.province_size()) {
+		ledger.provinces.resize(state.world.province_size());
+		ledger.province_owners.resize(state.world.province_size());
 	}
+}
 
-	concurrency::parallel_for(uint32_t(0), sys::national_mod_offsets::count, [&](uint32_t i) {
-		dcon::national_modifier_value mid{dcon::national_modifier_value::value_base_t(i)};
-		state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_modifier_values(ids, mid, ve::fp_vector{}); });
-	});
-
-	for(auto n : state.world.in_nation) {
-		if(auto ts = n.get_tech_school(); ts)
-			apply_modifier_values_to_nation(state, n, ts);
-	}
-	for(auto n : state.world.in_nation) {
-		if(auto nv = n.get_national_value(); nv)
-			apply_modifier_values_to_nation(state, n, nv);
-	}
-	for(auto n : state.world.in_nation) {
-		for(auto mpr : state.world.nation_get_current_modifiers(n)) {
-			apply_modifier_values_to_nation(state, n, mpr.mod_id);
-		}
-	}
-	state.world.for_each_technology([&](dcon::technology_id t) {
-		auto tmod = state.world.technology_get_modifier(t);
-		if(tmod) {
-			bulk_apply_masked_modifier_to_nations(state, tmod,
-					[&](auto ids) { return state.world.nation_get_active_technologies(ids, t); });
-		}
-	});
-	state.world.for_each_invention([&](dcon::invention_id i) {
-		auto tmod = state.world.invention_get_modifier(i);
-		if(tmod) {
-			bulk_apply_masked_modifier_to_nations(state, tmod,
-					[&](auto ids) { return state.world.nation_get_active_inventions(ids, i); });
-		}
-	});
-	state.world.for_each_issue([&](dcon::issue_id i) {
-		for(auto n : state.world.in_nation) {
-			auto iopt = state.world.nation_get_issues(n, i);
-			auto imod = state.world.issue_option_get_modifier(iopt);
-			if(imod && (n.get_is_civilized() || state.world.issue_get_issue_type(i) == uint8_t(culture::issue_type::party))) {
-				apply_modifier_values_to_nation(state, n, imod);
-			}
-		}
+// sorts contributions by modifier and merges the entries for modifiers that are provided by more than one source
+void normalize_contributions(std::vector<modifier_contribution>& contributions) {
+	std::sort(contributions.begin(), contributions.end(), [](modifier_contribution const& a, modifier_contribution const& b) {
+		return a.mod_id.index() < b.mod_id.index();
 	});
-	state.world.for_each_reform([&](dcon::reform_id i) {
-		for(auto n : state.world.in_nation) {
-			auto iopt = state.world.nation_get_reforms(n, i);
-			auto imod = state.world.reform_option_get_modifier(iopt);
-			if(imod && !n.get_is_civilized()) {
-				apply_modifier_values_to_nation(state, n, imod);
-			}
-		}
-	});
-	for(auto n : state.world.in_nation) {
-		auto in_wars = n.get_war_participant();
-		if(in_wars.begin() != in_wars.end()) {
-			if(state.national_definitions.war)
-				apply_modifier_values_to_nation(state, n, state.national_definitions.war);
-		} else {
-			if(state.national_definitions.peace)
-				apply_modifier_values_to_nation(state, n, state.national_definitions.peace);
-		}
-	}
-
-	if(state.national_definitions.badboy) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.badboy,
-				[&](auto ids) { return state.world.nation_get_infamy(ids); });
-	}
-	if(state.national_definitions.plurality) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.plurality,
-				[&](auto ids) { return state.world.nation_get_plurality(ids); });
-	}
-	if(state.national_definitions.war_exhaustion) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.war_exhaustion,
-				[&](auto ids) { return state.world.nation_get_war_exhaustion(ids); });
-	}
-	if(state.national_definitions.average_literacy) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.average_literacy, [&](auto ids) {
-			auto total = state.world.nation_get_demographics(ids, demographics::total);
-			return ve::select(total > 0, state.world.nation_get_demographics(ids, demographics::literacy) / total, 0.0f);
-		});
-	}
-	if(state.national_definitions.total_blockaded) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.total_blockaded, [&](auto ids) {
-			auto bc = ve::to_float(state.world.nation_get_central_blockaded(ids));
-			auto c = ve::to_float(state.world.nation_get_central_ports(ids));
-			return ve::select(c > 0.0f, bc / c, 0.0f);
-		});
-	}
-	if(state.national_definitions.total_occupation) {
-		bulk_apply_scaled_modifier_to_nations(state, state.national_definitions.total_occupation, [&](auto ids) {
-			return ve::apply(
-					[&](dcon::nation_id nid) {
-						auto n = fatten(state.world, nid);
-						auto cap_continent = n.get_capital().get_continent();
-						float total = 0.0f;
-						float occupied = 0.0f;
-						for(auto owned : n.get_province_ownership()) {
-							if(owned.get_province().get_continent() == cap_continent) {
-								total += 1.0f;
-								if(auto c = owned.get_province().get_nation_from_province_control().id; c && c != n.id) {
-									occupied += 1.0f;
-								}
-							}
-						}
-						if(total > 0.0f)
-							return 100.0f * occupied / total;
-						else
-							return 0.0f;
-					},
-					ids);
-		});
-	}
-	for(auto n : state.world.in_nation) {
-		if(n.get_is_civilized() == false) {
-			if(state.national_definitions.unciv_nation) {
-				apply_modifier_values_to_nation(state, n, state.national_definitions.unciv_nation);
-			}
-		} else if(nations::is_great_power(state, n)) {
-			if(state.national_definitions.great_power)
-				apply_modifier_values_to_nation(state, n, state.national_definitions.great_power);
-		} else if(n.get_rank() <= uint16_t(state.defines.colonial_rank)) {
-			if(state.national_definitions.second_power)
-				apply_modifier_values_to_nation(state, n, state.national_definitions.second_power);
+	uint32_t last = 0;
+	for(uint32_t i = 1; i < contributions.size(); ++i) {
+		if(contributions[i].mod_id == contributions[last].mod_id) {
+			contributions[last].scale += contributions[i].scale;
+			contributions[last].owner_scale += contributions[i].owner_scale;
 		} else {
-			if(state.national_definitions.civ_nation)
-				apply_modifier_values_to_nation(state, n, state.national_definitions.civ_nation);
-		}
-	}
-	if(state.national_definitions.disarming) {
-		for(auto n : state.world.in_nation) {
-			if(bool(n.get_disarmed_until()) && n.get_disarmed_until() > state.current_date) {
-				apply_modifier_values_to_nation(state, n, state.national_definitions.disarming);
-			}
-		}
-	}
-	if(state.national_definitions.in_bankrupcy) {
-		bulk_apply_masked_modifier_to_nations(state, state.national_definitions.in_bankrupcy,
-				[&](auto ids) { return state.world.nation_get_is_bankrupt(ids); });
-	}
-	// TODO: debt
-
-	for(auto tm : state.national_definitions.triggered_modifiers) {
-		if(tm.trigger_condition && tm.linked_modifier) {
-			auto& nat_values = state.world.modifier_get_national_values(tm.linked_modifier);
-			auto size_used = state.world.nation_size();
-			ve::execute_serial_fast<dcon::nation_id>(size_used, [&](auto nids) {
-				auto trigger_condition_satisfied =
-						trigger::evaluate(state, tm.trigger_condition, trigger::to_generic(nids), trigger::to_generic(nids), 0) &&
-						ve::apply([size_used](auto n) { return n.index() < int32_t(size_used); }, nids);
-				auto compressed_res = ve::compress_mask(trigger_condition_satisfied);
-				if(compressed_res.v == ve::vbitfield_type::storage(0)) {
-					return;
-				} else {
-					for(uint32_t i = 0; i < sys::national_modifier_definition::modifier_definition_size; ++i) {
-						if(!(nat_values.offsets[i]))
-							break; // no more modifier values attached
-
-						auto fixed_offset = nat_values.offsets[i];
-						auto modifier_amount = nat_values.values[i];
-						auto old_mod_value = state.world.nation_get_modifier_values(nids, fixed_offset);
-						state.world.nation_set_modifier_values(nids, fixed_offset,
-								ve::select(trigger_condition_satisfied, old_mod_value + modifier_amount, old_mod_value));
-					}
-				}
-			});
+			++last;
+			contributions[last] = contributions[i];
 		}
 	}
+	if(!contributions.empty())
+		contributions.resize(last + 1);
 }
 
-void update_single_nation_modifiers(sys::state& state, dcon::nation_id n) {
-
-	for(uint32_t i = uint32_t(0); i < sys::national_mod_offsets::count; ++i) {
-		dcon::national_modifier_value mid{dcon::national_modifier_value::value_base_t(i)};
-		state.world.nation_set_modifier_values(n, mid, 0.0f);
+// changes the recorded scale of a single modifier in the contributions of an entity
+void adjust_contribution(std::vector<modifier_contribution>& contributions, dcon::modifier_id mod_id, float delta, float owner_delta) {
+	auto it = std::lower_bound(contributions.begin(), contributions.end(), mod_id, [](modifier_contribution const& c, dcon::modifier_id m) {
+		return c.mod_id.index() < m.index();
+	});
+	if(it != contributions.end() && it->mod_id == mod_id) {
+		it->scale += delta;
+		it->owner_scale += owner_delta;
+		if(it->scale == 0.0f && it->owner_scale == 0.0f)
+			contributions.erase(it);
+	} else {
+		contributions.insert(it, modifier_contribution{ mod_id, delta, owner_delta });
 	}
+}
 
+template<typename F>
+void for_each_national_modifier_source(sys::state& state, dcon::nation_id n, F&& func) {
 	if(auto ts = state.world.nation_get_tech_school(n); ts)
-		apply_modifier_values_to_nation(state, n, ts);
-
+		func(ts, 1.0f);
 	if(auto nv = state.world.nation_get_national_value(n); nv)
-		apply_modifier_values_to_nation(state, n, nv);
+		func(nv, 1.0f);
 
 	for(auto mpr : state.world.nation_get_current_modifiers(n)) {
-		apply_modifier_values_to_nation(state, n, mpr.mod_id);
+		func(mpr.mod_id, 1.0f);
 	}
 
 	state.world.for_each_technology([&](dcon::technology_id t) {
 		auto tmod = state.world.technology_get_modifier(t);
-		if(tmod && state.world.nation_get_active_technologies(n, t)) {
-			apply_modifier_values_to_nation(state, n, tmod);
-		}
+		if(tmod && state.world.nation_get_active_technologies(n, t))
+			func(tmod, 1.0f);
 	});
 	state.world.for_each_invention([&](dcon::invention_id i) {
 		auto tmod = state.world.invention_get_modifier(i);
-		if(tmod && state.world.nation_get_active_inventions(n, i)) {
-			apply_modifier_values_to_nation(state, n, tmod);
-		}
+		if(tmod && state.world.nation_get_active_inventions(n, i))
+			func(tmod, 1.0f);
 	});
 	state.world.for_each_issue([&](dcon::issue_id i) {
 		auto iopt = state.world.nation_get_issues(n, i);
 		auto imod = state.world.issue_option_get_modifier(iopt);
-		if(imod &&
-				(state.world.nation_get_is_civilized(n) || state.world.issue_get_issue_type(i) == uint8_t(culture::issue_type::party))) {
-			apply_modifier_values_to_nation(state, n, imod);
-		}
+		if(imod && (state.world.nation_get_is_civilized(n) || state.world.issue_get_issue_type(i) == uint8_t(culture::issue_type::party)))
+			func(imod, 1.0f);
 	});
 	if(!state.world.nation_get_is_civilized(n)) {
 		state.world.for_each_reform([&](dcon::reform_id i) {
 			auto iopt = state.world.nation_get_reforms(n, i);
 			auto imod = state.world.reform_option_get_modifier(iopt);
-			if(imod) {
-				apply_modifier_values_to_nation(state, n, imod);
-			}
+			if(imod)
+				func(imod, 1.0f);
 		});
 	}
 
 	auto in_wars = state.world.nation_get_war_participant(n);
 	if(in_wars.begin() != in_wars.end()) {
 		if(state.national_definitions.war)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.war);
+			func(state.national_definitions.war, 1.0f);
 	} else {
 		if(state.national_definitions.peace)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.peace);
+			func(state.national_definitions.peace, 1.0f);
 	}
 
-	if(state.national_definitions.badboy) {
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.badboy, state.world.nation_get_infamy(n));
-	}
-	if(state.national_definitions.plurality) {
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.plurality, state.world.nation_get_plurality(n));
-	}
-	if(state.national_definitions.war_exhaustion) {
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.war_exhaustion,
-				state.world.nation_get_war_exhaustion(n));
-	}
+	if(state.national_definitions.badboy)
+		func(state.national_definitions.badboy, state.world.nation_get_infamy(n));
+	if(state.national_definitions.plurality)
+		func(state.national_definitions.plurality, state.world.nation_get_plurality(n));
+	if(state.national_definitions.war_exhaustion)
+		func(state.national_definitions.war_exhaustion, state.world.nation_get_war_exhaustion(n));
 	if(state.national_definitions.average_literacy) {
 		auto total = state.world.nation_get_demographics(n, demographics::total);
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.average_literacy,
+		func(state.national_definitions.average_literacy,
 				total > 0 ? state.world.nation_get_demographics(n, demographics::literacy) / total : 0.0f);
 	}
 	if(state.national_definitions.total_blockaded) {
-		auto bc = ve::to_float(state.world.nation_get_central_blockaded(n));
-		auto c = ve::to_float(state.world.nation_get_central_ports(n));
-
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.total_blockaded, c > 0.0f ? bc / c : 0.0f);
+		auto bc = float(state.world.nation_get_central_blockaded(n));
+		auto c = float(state.world.nation_get_central_ports(n));
+		func(state.national_definitions.total_blockaded, c > 0.0f ? bc / c : 0.0f);
 	}
 	if(state.national_definitions.total_occupation) {
 		auto nid = fatten(state.world, n);
@@ -514,52 +233,212 @@ void update_single_nation_modifiers(sys::state& state, dcon::nation_id n) {
 				}
 			}
 		}
-
-		apply_scaled_modifier_values_to_nation(state, n, state.national_definitions.total_occupation,
-				total > 0.0f ? occupied / total : 0.0f);
+		func(state.national_definitions.total_occupation, total > 0.0f ? 100.0f * occupied / total : 0.0f);
 	}
 
 	if(state.world.nation_get_is_civilized(n) == false) {
 		if(state.national_definitions.unciv_nation)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.unciv_nation);
+			func(state.national_definitions.unciv_nation, 1.0f);
 	} else if(nations::is_great_power(state, n)) {
 		if(state.national_definitions.great_power)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.great_power);
+			func(state.national_definitions.great_power, 1.0f);
 	} else if(state.world.nation_get_rank(n) <= uint16_t(state.defines.colonial_rank)) {
 		if(state.national_definitions.second_power)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.second_power);
+			func(state.national_definitions.second_power, 1.0f);
 	} else {
 		if(state.national_definitions.civ_nation)
-			apply_modifier_values_to_nation(state, n, state.national_definitions.civ_nation);
+			func(state.national_definitions.civ_nation, 1.0f);
 	}
 
 	if(state.national_definitions.disarming) {
-		if(bool(state.world.nation_get_disarmed_until(n)) && state.world.nation_get_disarmed_until(n) > state.current_date) {
-			apply_modifier_values_to_nation(state, n, state.national_definitions.disarming);
-		}
+		if(bool(state.world.nation_get_disarmed_until(n)) && state.world.nation_get_disarmed_until(n) > state.current_date)
+			func(state.national_definitions.disarming, 1.0f);
 	}
 	if(state.national_definitions.in_bankrupcy) {
-		if(bool(state.world.nation_get_is_bankrupt(n))) {
-			apply_modifier_values_to_nation(state, n, state.national_definitions.in_bankrupcy);
-		}
+		if(state.world.nation_get_is_bankrupt(n))
+			func(state.national_definitions.in_bankrupcy, 1.0f);
 	}
 	// TODO: debt
 
 	for(auto tm : state.national_definitions.triggered_modifiers) {
 		if(tm.trigger_condition && tm.linked_modifier) {
+			if(trigger::evaluate(state, tm.trigger_condition, trigger::to_generic(n), trigger::to_generic(n), 0))
+				func(tm.linked_modifier, 1.0f);
+		}
+	}
+}
+
+// func(modifier, scale, owner_scale): the scale is applied to the provincial values of the modifier, and the owner scale
+// to its national values on the owner of the province
+template<typename F>
+void for_each_provincial_modifier_source(sys::state& state, dcon::province_id p, F&& func) {
+	if(state.national_definitions.land_province)
+		func(state.national_definitions.land_province, 1.0f, 0.0f);
+
+	for(auto mpr : state.world.province_get_current_modifiers(p)) {
+		func(mpr.mod_id, 1.0f, 1.0f);
+	}
+
+	if(auto m = state.world.province_get_terrain(p); m)
+		func(m, 1.0f, 1.0f);
+	if(auto m = state.world.province_get_climate(p); m)
+		func(m, 1.0f, 1.0f);
+	if(auto m = state.world.province_get_continent(p); m)
+		func(m, 1.0f, 1.0f);
+	if(auto m = state.world.province_get_state_membership(p).get_owner_focus(); m) {
+		if(auto fm = m.get_modifier(); fm)
+			func(fm, 1.0f, 1.0f);
+	}
+	if(auto c = state.world.province_get_crime(p); c) {
+		if(auto m = state.culture_definitions.crimes[c].modifier; m)
+			func(m, 1.0f, 1.0f);
+	}
+
+	for(auto t = economy::province_building_type::railroad; t != economy::province_building_type::last; t = economy::province_building_type(uint8_t(t) + 1)) {
+		if(auto m = state.economy_definitions.building_definitions[int32_t(t)].province_modifier; m) {
+			auto level = float(state.world.province_get_building_level(p, uint8_t(t)));
+			func(m, level, level);
+		}
+	}
+	if(state.national_definitions.infrastructure) {
+		auto infra = float(state.world.province_get_building_level(p, uint8_t(economy::province_building_type::railroad))) *
+			state.economy_definitions.building_definitions[int32_t(economy::province_building_type::railroad)].infrastructure;
+		func(state.national_definitions.infrastructure, infra, infra);
+	}
+	if(state.national_definitions.nationalism) {
+		auto nat = state.world.province_get_is_owner_core(p) ? 0.0f : state.world.province_get_nationalism(p);
+		func(state.national_definitions.nationalism, nat, nat);
+	}
+	if(state.national_definitions.non_coastal && !state.world.province_get_is_coast(p))
+		func(state.national_definitions.non_coastal, 1.0f, 1.0f);
+	if(state.national_definitions.coastal && state.world.province_get_is_coast(p))
+		func(state.national_definitions.coastal, 1.0f, 1.0f);
+	if(state.national_definitions.overseas && province::is_overseas(state, p))
+		func(state.national_definitions.overseas, 1.0f, 1.0f);
+	if(state.national_definitions.core && state.world.province_get_is_owner_core(p))
+		func(state.national_definitions.core, 1.0f, 1.0f);
+	if(state.national_definitions.has_siege && military::province_is_under_siege(state, p))
+		func(state.national_definitions.has_siege, 1.0f, 1.0f);
+	if(state.national_definitions.blockaded && military::province_is_blockaded(state, p))
+		func(state.national_definitions.blockaded, 1.0f, 1.0f);
+}
+
+void collect_national_contributions(sys::state& state, dcon::nation_id n, std::vector<modifier_contribution>& out) {
+	out.clear();
+	for_each_national_modifier_source(state, n, [&](dcon::modifier_id m, float scale) {
+		if(scale != 0.0f)
+			out.push_back(modifier_contribution{ m, scale, 0.0f });
+	});
+	normalize_contributions(out);
+}
+
+void collect_provincial_contributions(sys::state& state, dcon::province_id p, std::vector<modifier_contribution>& out) {
+	out.clear();
+	for_each_provincial_modifier_source(state, p, [&](dcon::modifier_id m, float scale, float owner_scale) {
+		if(scale != 0.0f || owner_scale != 0.0f)
+			out.push_back(modifier_contribution{ m, scale, owner_scale });
+	});
+	normalize_contributions(out);
+}
 
-			auto trigger_condition_satisfied =
-					trigger::evaluate(state, tm.trigger_condition, trigger::to_generic(n), trigger::to_generic(n), 0);
+// applies the difference between the recorded and the desired contributions of a nation, then records the desired ones
+void settle_national_contributions(sys::state& state, dcon::nation_id n, std::vector<modifier_contribution>& desired) {
+	auto& applied = state.applied_modifiers.nations[n.index()];
+	size_t i = 0;
+	size_t j = 0;
+	while(i < desired.size() || j < applied.size()) {
+		if(j == applied.size() || (i < desired.size() && desired[i].mod_id.index() < applied[j].mod_id.index())) {
+			apply_scaled_modifier_values_to_nation(state, n, desired[i].mod_id, desired[i].scale);
+			++i;
+		} else if(i == desired.size() || applied[j].mod_id.index() < desired[i].mod_id.index()) {
+			apply_scaled_modifier_values_to_nation(state, n, applied[j].mod_id, -applied[j].scale);
+			++j;
+		} else {
+			if(desired[i].scale != applied[j].scale)
+				apply_scaled_modifier_values_to_nation(state, n, desired[i].mod_id, desired[i].scale - applied[j].scale);
+			++i;
+			++j;
+		}
+	}
+	applied.swap(desired);
+}
 
-			if(trigger_condition_satisfied) {
-				apply_modifier_values_to_nation(state, n, tm.linked_modifier);
+// as above, but only for the provincial values; the national values on the owner are settled by settle_owner_contributions
+void settle_provincial_contributions(sys::state& state, dcon::province_id p, std::vector<modifier_contribution> const& desired) {
+	auto const& applied = state.applied_modifiers.provinces[p.index()];
+	size_t i = 0;
+	size_t j = 0;
+	while(i < desired.size() || j < applied.size()) {
+		if(j == applied.size() || (i < desired.size() && desired[i].mod_id.index() < applied[j].mod_id.index())) {
+			if(desired[i].scale != 0.0f)
+				apply_scaled_modifier_values_to_province(state, p, desired[i].mod_id, desired[i].scale);
+			++i;
+		} else if(i == desired.size() || applied[j].mod_id.index() < desired[i].mod_id.index()) {
+			if(applied[j].scale != 0.0f)
+				apply_scaled_modifier_values_to_province(state, p, applied[j].mod_id, -applied[j].scale);
+			++j;
+		} else {
+			if(desired[i].scale != applied[j].scale)
+				apply_scaled_modifier_values_to_province(state, p, desired[i].mod_id, desired[i].scale - applied[j].scale);
+			++i;
+			++j;
+		}
+	}
+}
+
+// moves the national values contributed by a province to its current owner, then records the desired contributions
+void settle_owner_contributions(sys::state& state, dcon::province_id p, std::vector<modifier_contribution>& desired) {
+	auto& applied = state.applied_modifiers.provinces[p.index()];
+	auto& applied_owner = state.applied_modifiers.province_owners[p.index()];
+	auto owner = state.world.province_get_nation_from_province_ownership(p);
+
+	if(owner != applied_owner) {
+		if(applied_owner) {
+			for(auto& c : applied) {
+				if(c.owner_scale != 0.0f)
+					apply_scaled_modifier_values_to_nation(state, applied_owner, c.mod_id, -c.owner_scale);
+			}
+		}
+		if(owner) {
+			for(auto& c : desired) {
+				if(c.owner_scale != 0.0f)
+					apply_scaled_modifier_values_to_nation(state, owner, c.mod_id, c.owner_scale);
+			}
+		}
+	} else if(owner) {
+		size_t i = 0;
+		size_t j = 0;
+		while(i < desired.size() || j < applied.size()) {
+			if(j == applied.size() || (i < desired.size() && desired[i].mod_id.index() < applied[j].mod_id.index())) {
+				if(desired[i].owner_scale != 0.0f)
+					apply_scaled_modifier_values_to_nation(state, owner, desired[i].mod_id, desired[i].owner_scale);
+				++i;
+			} else if(i == desired.size() || applied[j].mod_id.index() < desired[i].mod_id.index()) {
+				if(applied[j].owner_scale != 0.0f)
+					apply_scaled_modifier_values_to_nation(state, owner, applied[j].mod_id, -applied[j].owner_scale);
+				++j;
+			} else {
+				if(desired[i].owner_scale != applied[j].owner_scale)
+					apply_scaled_modifier_values_to_nation(state, owner, desired[i].mod_id, desired[i].owner_scale - applied[j].owner_scale);
+				++i;
+				++j;
 			}
 		}
 	}
+
+	applied_owner = owner;
+	applied.swap(desired);
 }
 
-void recreate_province_modifiers(sys::state& state) {
-	// purge expired triggered modifiers
+void purge_expired_modifiers(sys::state& state) {
+	for(auto n : state.world.in_nation) {
+		auto timed_modifiers = n.get_current_modifiers();
+		for(uint32_t i = timed_modifiers.size(); i-- > 0;) {
+			if(bool(timed_modifiers[i].expiration) && timed_modifiers[i].expiration < state.current_date) {
+				timed_modifiers.remove_at(i);
+			}
+		}
+	}
 	province::for_each_land_province(state, [&](dcon::province_id p) {
 		auto timed_modifiers = state.world.province_get_current_modifiers(p);
 		for(uint32_t i = timed_modifiers.size(); i-- > 0;) {
@@ -568,100 +447,124 @@ void recreate_province_modifiers(sys::state& state) {
 			}
 		}
 	});
+}
 
-	concurrency::parallel_for(uint32_t(0), sys::provincial_mod_offsets::count, [&](uint32_t i) {
-		dcon::provincial_modifier_value mid{dcon::provincial_modifier_value::value_base_t(i)};
-		province::ve_for_each_land_province(state,
-				[&](auto ids) { state.world.province_set_modifier_values(ids, mid, ve::fp_vector{}); });
-	});
-
-	if(state.national_definitions.land_province)
-		bulk_apply_modifier_to_provinces(state, state.national_definitions.land_province);
+void settle_all_modifier_contributions(sys::state& state) {
+	ensure_ledger_size(state);
+	auto& ledger = state.applied_modifiers;
+	auto land_count = uint32_t(state.province_definitions.first_sea_province.index());
 
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		for(auto mpr : state.world.province_get_current_modifiers(p)) {
-			apply_modifier_values_to_province(state, p, mpr.mod_id);
-		}
-	});
+	ledger.pending_nations.resize(state.world.nation_size());
+	ledger.pending_provinces.resize(land_count);
 
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		if(auto m = state.world.province_get_terrain(p); m)
-			apply_modifier_values_to_province(state, p, m);
-	});
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		if(auto m = state.world.province_get_climate(p); m)
-			apply_modifier_values_to_province(state, p, m);
+	// the desired contributions are collected before anything is written so that the result does not depend on the order in
+	// which the threads run, even when a triggered modifier looks at modifier values
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		collect_national_contributions(state, dcon::nation_id{ dcon::nation_id::value_base_t(i) }, ledger.pending_nations[i]);
 	});
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		if(auto m = state.world.province_get_continent(p); m)
-			apply_modifier_values_to_province(state, p, m);
+	concurrency::parallel_for(uint32_t(0), land_count, [&](uint32_t i) {
+		collect_provincial_contributions(state, dcon::province_id{ dcon::province_id::value_base_t(i) }, ledger.pending_provinces[i]);
 	});
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		if(auto m = state.world.province_get_state_membership(p).get_owner_focus(); m)
-			apply_modifier_values_to_province(state, p, m.get_modifier());
+
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		settle_national_contributions(state, dcon::nation_id{ dcon::nation_id::value_base_t(i) }, ledger.pending_nations[i]);
 	});
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		if(auto c = state.world.province_get_crime(p); c) {
-			if(auto m = state.culture_definitions.crimes[c].modifier; m)
-				apply_modifier_values_to_province(state, p, m);
-		}
+	concurrency::parallel_for(uint32_t(0), land_count, [&](uint32_t i) {
+		settle_provincial_contributions(state, dcon::province_id{ dcon::province_id::value_base_t(i) }, ledger.pending_provinces[i]);
 	});
-
-	for(auto t = economy::province_building_type::railroad; t != economy::province_building_type::last; t = economy::province_building_type(uint8_t(t) + 1)) {
-		if(state.economy_definitions.building_definitions[int32_t(t)].province_modifier) {
-			bulk_apply_scaled_modifier_to_provinces(state, state.economy_definitions.building_definitions[int32_t(t)].province_modifier,
-					[&](auto ids) { return ve::to_float(state.world.province_get_building_level(ids, uint8_t(t))); });
-		}
+	// several provinces may share an owner, so this part must be serial
+	for(uint32_t i = 0; i < land_count; ++i) {
+		settle_owner_contributions(state, dcon::province_id{ dcon::province_id::value_base_t(i) }, ledger.pending_provinces[i]);
 	}
-	if(state.national_definitions.infrastructure) {
-		bulk_apply_scaled_modifier_to_provinces(state, state.national_definitions.infrastructure, [&](auto ids) {
-			return ve::to_float(state.world.province_get_building_level(ids, uint8_t(economy::province_building_type::railroad))) *
-						 state.economy_definitions.building_definitions[int32_t(economy::province_building_type::railroad)].infrastructure;
-		});
-	}
-	if(state.national_definitions.nationalism) {
-		bulk_apply_scaled_modifier_to_provinces(state, state.national_definitions.nationalism, [&](auto ids) {
-			return ve::select(state.world.province_get_is_owner_core(ids), 0.0f, state.world.province_get_nationalism(ids));
-		});
-	}
-	if(state.national_definitions.non_coastal) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.non_coastal,
-				[&](auto ids) { return !state.world.province_get_is_coast(ids); });
-	}
-	if(state.national_definitions.coastal) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.coastal,
-				[&](auto ids) { return state.world.province_get_is_coast(ids); });
-	}
-	if(state.national_definitions.overseas) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.overseas,
-				[&](auto ids) { return province::is_overseas(state, ids); });
-	}
-	if(state.national_definitions.core) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.core,
-				[&](auto ids) { return state.world.province_get_is_owner_core(ids); });
-	}
-	if(state.national_definitions.has_siege) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.has_siege,
-				[&](auto ids) { return military::province_is_under_siege(state, ids); });
+}
+
+} // namespace
+
+void apply_modifier_delta_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id, float delta) {
+	if(!mod_id || delta == 0.0f)
+		return;
+
+	apply_scaled_modifier_values_to_nation(state, target_nation, mod_id, delta);
+	if(state.applied_modifiers.valid) {
+		ensure_ledger_size(state);
+		adjust_contribution(state.applied_modifiers.nations[target_nation.index()], mod_id, delta, 0.0f);
 	}
-	if(state.national_definitions.blockaded) {
-		bulk_apply_masked_modifier_to_provinces(state, state.national_definitions.blockaded,
-				[&](auto ids) { return military::province_is_blockaded(state, ids); });
+}
+
+void apply_modifier_delta_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, float delta) {
+	if(!mod_id || delta == 0.0f || !is_land_province(state, target_prov))
+		return;
+
+	apply_scaled_modifier_values_to_province(state, target_prov, mod_id, delta);
+	if(state.applied_modifiers.valid) {
+		ensure_ledger_size(state);
+		// the national values go to the nation recorded in the ledger; a change of owner is settled in the next update
+		auto owner = state.applied_modifiers.province_owners[target_prov.index()];
+		if(owner)
+			apply_scaled_modifier_values_to_nation(state, owner, mod_id, delta);
+		adjust_contribution(state.applied_modifiers.provinces[target_prov.index()], mod_id, delta, owner ? delta : 0.0f);
+	} else if(auto owner = state.world.province_get_nation_from_province_ownership(target_prov); owner) {
+		apply_scaled_modifier_values_to_nation(state, owner, mod_id, delta);
 	}
 }
 
+void rebuild_modifier_effects(sys::state& state) {
+	purge_expired_modifiers(state);
+
+	concurrency::parallel_for(uint32_t(0), sys::national_mod_offsets::count, [&](uint32_t i) {
+		dcon::national_modifier_value mid{dcon::national_modifier_value::value_base_t(i)};
+		state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_modifier_values(ids, mid, ve::fp_vector{}); });
+	});
+	concurrency::parallel_for(uint32_t(0), sys::provincial_mod_offsets::count, [&](uint32_t i) {
+		dcon::provincial_modifier_value mid{dcon::provincial_modifier_value::value_base_t(i)};
+		province::ve_for_each_land_province(state,
+				[&](auto ids) { state.world.province_set_modifier_values(ids, mid, ve::fp_vector{}); });
+	});
+
+	auto& ledger = state.applied_modifiers;
+	for(auto& l : ledger.nations)
+		l.clear();
+	for(auto& l : ledger.provinces)
+		l.clear();
+	for(auto& o : ledger.province_owners)
+		o = dcon::nation_id{};
+
+	settle_all_modifier_contributions(state);
+	ledger.valid = true;
+}
+
+void update_single_nation_modifiers(sys::state& state, dcon::nation_id n) {
+	if(!state.applied_modifiers.valid)
+		return; // everything will be built from scratch by repopulate_modifier_effects
+
+	ensure_ledger_size(state);
+	std::vector<modifier_contribution> desired;
+	collect_national_contributions(state, n, desired);
+	settle_national_contributions(state, n, desired);
+}
+
 // restores values after loading a save
 void repopulate_modifier_effects(sys::state& state) {
-	recreate_national_modifiers(state);
-	recreate_province_modifiers(state);
+	rebuild_modifier_effects(state);
 	for(auto n : state.world.in_nation) {
 		economy::bound_budget_settings(state, n);
 	}
 }
 
 void update_modifier_effects(sys::state& state) {
-	recreate_national_modifiers(state);
-	recreate_province_modifiers(state);
+	/*
+	Once a month, the modifier values of every nation and land province are brought in line with their current sources. Only
+	the sources whose scale changed since the last update are applied, as signed deltas. A full rebuild is done once a year, to
+	discard any accumulated rounding error, or every month if alice_full_modifier_recreation is set (to validate the incremental
+	results).
+	*/
+	auto ymd = state.current_date.to_ymd(state.start_date);
+	if(!state.applied_modifiers.valid || ymd.month == 1 || state.defines.alice_full_modifier_recreation != 0.0f) {
+		rebuild_modifier_effects(state);
+	} else {
+		purge_expired_modifiers(state);
+		settle_all_modifier_contributions(state);
+	}
 	for(auto n : state.world.in_nation) {
 		economy::bound_budget_settings(state, n);
 	}
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <vector>
 #include "date_interface.hpp"
 #include "dcon_generated.hpp"
 
@@ -325,8 +326,27 @@ static_assert(sizeof(dated_modifier) ==
 	sizeof(dated_modifier::expiration)
 	+ sizeof(dated_modifier::mod_id));
 
+struct modifier_contribution {
+	dcon::modifier_id mod_id;
+	float scale = 0.0f; // multiplies the values of the modifier on the entity itself
+	float owner_scale = 0.0f; // provinces only: multiplies the national values of the modifier on the owner of the province
+};
+
+// records which modifiers are currently folded into the modifier values of each nation and land province (not saved)
+struct modifier_ledger {
+	std::vector<std::vector<modifier_contribution>> nations; // sorted by modifier
+	std::vector<std::vector<modifier_contribution>> provinces; // sorted by modifier
+	std::vector<dcon::nation_id> province_owners; // the nation that currently holds the national values of each province
+
+	std::vector<std::vector<modifier_contribution>> pending_nations; // scratch space for the monthly update
+	std::vector<std::vector<modifier_contribution>> pending_provinces;
+
+	bool valid = false; // false until the first full rebuild
+};
+
 // restores values after loading a save
 void repopulate_modifier_effects(sys::state& state);
+void rebuild_modifier_effects(sys::state& state);
 
 void update_modifier_effects(sys::state& state);
 void update_single_nation_modifiers(sys::state& state, dcon::nation_id n);
@@ -342,4 +362,9 @@ void remove_expired_modifiers_from_province(sys::state& state, dcon::province_id
 
 void toggle_modifier_from_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, sys::date expiration);
 
+// adds delta times the values of the modifier to the entity and records the change in the modifier ledger
+// (a negative delta removes the modifier again)
+void apply_modifier_delta_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id, float delta);
+void apply_modifier_delta_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, float delta);
+
 } // namespace sys
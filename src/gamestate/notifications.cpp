@@ -3,12 +3,32 @@
 
 namespace notification {
 
+uint8_t message_settings(sys::state& state, sys::message_base_type type, dcon::nation_id source, dcon::nation_id target, dcon::nation_id third) {
+	auto setting_types = sys::message_setting_map[int32_t(type)];
+	auto const& settings = state.user_settings;
+	auto bits_for = [&](sys::message_setting_type t, dcon::nation_id n) -> uint8_t {
+		if(t == sys::message_setting_type::count)
+			return 0;
+		if(n == state.local_player_nation)
+			return settings.self_message_settings[int32_t(t)];
+		if(nation_is_interesting(state, n))
+			return settings.interesting_message_settings[int32_t(t)];
+		return settings.other_message_settings[int32_t(t)];
+	};
+	return uint8_t(bits_for(setting_types.source, source) | bits_for(setting_types.target, target) | bits_for(setting_types.third, third));
+}
+
+bool wanted(sys::state& state, sys::message_base_type type, dcon::nation_id source, dcon::nation_id target, dcon::nation_id third) {
+	// nothing ever drains the queue without a window
+	if(state.headless)
+		return false;
+	// a message with no response bits set is neither logged, shown nor played when it is consumed
+	return message_settings(state, type, source, target, third) != 0;
+}
+
 void post(sys::state& state, message&& m) {
-	//
-	// TODO: pre filter out any messages that the player is not interested in at all according to their message settings.
-	// But, probably don't try to fiter out by "interesting" except for considering whether the player nation is itself involved
-	// as that will probably be a more computationally expensive check
-	//
+	if(!wanted(state, m.type, m.source, m.target, m.third))
+		return;
 
 	bool v = state.new_messages.try_emplace(std::move(m));
 	assert(v);
@@ -14,6 +14,11 @@ struct message {
 	sys::message_base_type type;
 };
 
+// the response bits (see sys::message_response) the local player's settings assign to a message of this type and participants
+uint8_t message_settings(sys::state& state, sys::message_base_type type, dcon::nation_id source, dcon::nation_id target, dcon::nation_id third);
+// whether posting such a message would have any visible effect; hot call sites may check this before building the body
+bool wanted(sys::state& state, sys::message_base_type type, dcon::nation_id source, dcon::nation_id target = dcon::nation_id{}, dcon::nation_id third = dcon::nation_id{});
+// drops the message immediately if it is not wanted
 void post(sys::state& state, message&& m);
 bool nation_is_interesting(sys::state& state, dcon::nation_id n);
 
@@ -60,14 +60,6 @@ void read_mod_path(uint8_t const* ptr_in, uint8_t const* lim, native_string& pat
 
 	path_out = native_string(native_string_view(reinterpret_cast<native_char const*>(ptr_in), length));
 }
-uint8_t const* load_mod_path(uint8_t const* ptr_in, sys::state& state) {
-	uint32_t length = 0;
-	memcpy(&length, ptr_in, sizeof(uint32_t));
-	ptr_in += sizeof(uint32_t);
-
-	simple_fs::restore_state(state.common_fs, native_string_view(reinterpret_cast<native_char const*>(ptr_in), length));
-	return ptr_in + length * sizeof(native_char);
-}
 uint8_t* write_mod_path(uint8_t* ptr_in, native_string const& path_in) {
 	uint32_t length = uint32_t(path_in.length());
 	memcpy(ptr_in, &length, sizeof(uint32_t));
@@ -115,25 +107,6 @@ uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint3
 	return ptr_out + sizeof(uint32_t) * 2 + section_length;
 }
 
-template<typename T>
-uint8_t const* with_decompressed_section(uint8_t const* ptr_in, T const& function) {
-	uint32_t section_length = 0;
-	uint32_t decompressed_length = 0;
-	memcpy(&section_length, ptr_in, sizeof(uint32_t));
-	memcpy(&decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
-
-	uint8_t* temp_buffer = new uint8_t[decompressed_length];
-	// TODO: allocate memory for decompression and decompress into it
-
-	ZSTD_decompress(temp_buffer, decompressed_length, ptr_in + sizeof(uint32_t) * 2, section_length);
-
-	// function(ptr_in + sizeof(uint32_t) * 2, decompressed_length);
-	function(temp_buffer, decompressed_length);
-
-	delete[] temp_buffer;
-	return ptr_in + sizeof(uint32_t) * 2 + section_length;
-}
-
 uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* section_end, sys::state& state) {
 	// hand-written contribution
 	{ // map
@@ -869,126 +842,446 @@ void write_scenario_file(sys::state& state, native_string_view name, uint32_t co
 
 	delete[] temp_buffer;
 }
-bool try_read_scenario_file(sys::state& state, native_string_view name) {
-	auto dir = simple_fs::get_or_create_scenario_directory();
-	auto save_file = open_file(dir, name);
-	if(save_file) {
-		scenario_header header;
-		header.version = 0;
+namespace {
 
-		auto contents = simple_fs::view_contents(*save_file);
-		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
-		auto file_end = buffer_pos + contents.file_size;
+struct scenario_input_manifest_header {
+	static constexpr uint32_t current_version = 2;
 
-		if(contents.file_size > sizeof_scenario_header(header)) {
-			buffer_pos = read_scenario_header(buffer_pos, header);
-		}
+	uint32_t version = current_version;
+	uint32_t scenario_version = scenario_file_version;
+	uint32_t entry_count = 0;
+};
 
-		if(header.version != sys::scenario_file_version) {
-			return false;
-		}
+struct scenario_input {
+	std::string path;
+	simple_fs::unopened_file file;
+	simple_fs::file_stamp stamp;
+	checksum_key hash;
+};
 
-		state.scenario_counter = header.count;
-		state.scenario_time_stamp = header.timestamp;
-		state.scenario_checksum = header.checksum;
-		state.loaded_save_file = NATIVE("");
-		state.loaded_scenario_file = name;
+bool is_run_time_input(std::string_view path) {
+	return path == "assets/localisation";
+}
 
-		buffer_pos = load_mod_path(buffer_pos, state);
+void collect_scenario_inputs(simple_fs::directory const& dir, std::string const& prefix, std::vector<scenario_input>& out) {
+	for(auto& f : simple_fs::list_files(dir, NATIVE(""))) {
+		auto name = simple_fs::native_to_utf8(simple_fs::get_file_name(f));
+		out.push_back(scenario_input{ prefix + name, f, simple_fs::file_stamp{}, checksum_key{} });
+	}
+	for(auto& d : simple_fs::list_subdirectories(dir)) {
+		auto full_name = simple_fs::get_full_name(d);
+		auto name = simple_fs::native_to_utf8(full_name.substr(full_name.find_last_of(NATIVE_DIR_SEPARATOR) + 1));
+		auto path = prefix + name;
+		if(!is_run_time_input(path))
+			collect_scenario_inputs(d, path + "/", out);
+	}
+}
 
-		buffer_pos = with_decompressed_section(buffer_pos,
-				[&](uint8_t const* ptr_in, uint32_t length) { read_scenario_section(ptr_in, ptr_in + length, state); });
+struct manifest_entry_view {
+	std::string_view path;
+	simple_fs::file_stamp stamp;
+	checksum_key const* hash = nullptr;
+};
 
-		return true;
-	} else {
+bool read_manifest_entries(char const* data, size_t size, std::vector<manifest_entry_view>& out) {
+	scenario_input_manifest_header header;
+	if(size < sizeof(header))
+		return false;
+	std::memcpy(&header, data, sizeof(header));
+	if(header.version != scenario_input_manifest_header::current_version || header.scenario_version != scenario_file_version)
 		return false;
+	size_t pos = sizeof(header);
+	out.reserve(header.entry_count);
+	for(uint32_t i = 0; i < header.entry_count; ++i) {
+		uint32_t length = 0;
+		if(size - pos < sizeof(length))
+			return false;
+		std::memcpy(&length, data + pos, sizeof(length));
+		pos += sizeof(length);
+		if(size - pos < uint64_t(length) + sizeof(simple_fs::file_stamp) + sizeof(checksum_key))
+			return false;
+		manifest_entry_view entry;
+		entry.path = std::string_view(data + pos, length);
+		std::memcpy(&entry.stamp, data + pos + length, sizeof(simple_fs::file_stamp));
+		entry.hash = reinterpret_cast<checksum_key const*>(data + pos + length + sizeof(simple_fs::file_stamp));
+		out.push_back(entry);
+		pos += length + sizeof(simple_fs::file_stamp) + sizeof(checksum_key);
 	}
+	return pos == size;
 }
 
-bool try_read_scenario_and_save_file(sys::state& state, native_string_view name) {
-	auto dir = simple_fs::get_or_create_scenario_directory();
-	auto save_file = open_file(dir, name);
-	if(save_file) {
-		scenario_header header;
-		header.version = 0;
+native_string scenario_input_manifest_name(native_string_view name) {
+	return native_string(name) + NATIVE(".inputs");
+}
 
-		auto contents = simple_fs::view_contents(*save_file);
-		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
-		auto file_end = buffer_pos + contents.file_size;
+} // namespace
+
+std::vector<native_string> const& scenario_input_directories() {
+	// what load_scenario_data and the map loader parse. Of gfx, the build picks the technology, decision and event images and
+	// the leader portraits by which files exist; gfx/flags is only checked for missing flags and is left out
+	static std::vector<native_string> const directories{
+		NATIVE("assets"), NATIVE("battleplans"), NATIVE("common"), NATIVE("decisions"), NATIVE("events"),
+		NATIVE("gfx/interface/leaders"), NATIVE("gfx/pictures"), NATIVE("history"), NATIVE("interface"), NATIVE("inventions"),
+		NATIVE("map"), NATIVE("news"), NATIVE("poptypes"), NATIVE("scripted triggers"), NATIVE("technologies"), NATIVE("tutorial"),
+		NATIVE("units")
+	};
+	return directories;
+}
 
-		if(contents.file_size > sizeof_scenario_header(header)) {
-			buffer_pos = read_scenario_header(buffer_pos, header);
+std::vector<char> make_scenario_input_manifest(simple_fs::file_system const& fs, std::vector<char> const& previous, std::vector<native_string> const& directories) {
+	std::vector<scenario_input> inputs;
+	auto root = simple_fs::get_root(fs);
+	for(auto& d : directories) {
+		if(d.empty())
+			collect_scenario_inputs(root, "", inputs);
+		else
+			collect_scenario_inputs(simple_fs::open_directory(root, d), simple_fs::native_to_utf8(d) + "/", inputs);
+	}
+	std::sort(inputs.begin(), inputs.end(), [](scenario_input const& a, scenario_input const& b) { return a.path < b.path; });
+
+	std::vector<manifest_entry_view> previous_entries;
+	if(!read_manifest_entries(previous.data(), previous.size(), previous_entries))
+		previous_entries.clear();
+
+	// files whose size and write time match the previous manifest keep their hash; only the others are read
+	std::vector<uint32_t> to_hash;
+	size_t j = 0;
+	for(uint32_t i = 0; i < uint32_t(inputs.size()); ++i) {
+		auto& input = inputs[i];
+		input.stamp = simple_fs::get_file_stamp(input.file);
+		while(j < previous_entries.size() && previous_entries[j].path < input.path)
+			++j;
+		if(j < previous_entries.size() && previous_entries[j].path == input.path
+			&& previous_entries[j].stamp.size == input.stamp.size && previous_entries[j].stamp.last_write_time == input.stamp.last_write_time
+			&& input.stamp.last_write_time != 0) {
+			input.hash = *previous_entries[j].hash;
+		} else {
+			to_hash.push_back(i);
+		}
+	}
+	concurrency::parallel_for(uint32_t(0), uint32_t(to_hash.size()), [&](uint32_t k) {
+		auto& input = inputs[to_hash[k]];
+		if(auto f = simple_fs::open_file(input.file); f) {
+			auto content = simple_fs::view_contents(*f);
+			blake2b(&input.hash, sizeof(checksum_key), content.data, content.file_size, nullptr, 0);
 		}
+	});
+
+	scenario_input_manifest_header header;
+	header.entry_count = uint32_t(inputs.size());
+	std::vector<char> result(sizeof(header));
+	std::memcpy(result.data(), &header, sizeof(header));
+	for(auto& i : inputs) {
+		uint32_t length = uint32_t(i.path.size());
+		auto pos = result.size();
+		result.resize(pos + sizeof(length) + length + sizeof(simple_fs::file_stamp) + sizeof(checksum_key));
+		std::memcpy(result.data() + pos, &length, sizeof(length));
+		std::memcpy(result.data() + pos + sizeof(length), i.path.data(), length);
+		std::memcpy(result.data() + pos + sizeof(length) + length, &i.stamp, sizeof(simple_fs::file_stamp));
+		std::memcpy(result.data() + pos + sizeof(length) + length + sizeof(simple_fs::file_stamp), &i.hash, sizeof(checksum_key));
+	}
+	return result;
+}
 
-		if(header.version != sys::scenario_file_version) {
-			return false;
+std::vector<std::string> changed_scenario_inputs(char const* old_data, size_t old_size, std::vector<char> const& current) {
+	std::vector<manifest_entry_view> old_entries;
+	std::vector<manifest_entry_view> new_entries;
+	if(!read_manifest_entries(old_data, old_size, old_entries) || !read_manifest_entries(current.data(), current.size(), new_entries))
+		return std::vector<std::string>{ std::string{} };
+
+	// both lists are sorted by path, so a single merge finds every difference
+	std::vector<std::string> changed;
+	size_t i = 0;
+	size_t j = 0;
+	while(i < old_entries.size() || j < new_entries.size()) {
+		if(j == new_entries.size() || (i < old_entries.size() && old_entries[i].path < new_entries[j].path)) {
+			changed.emplace_back(old_entries[i].path);
+			++i;
+		} else if(i == old_entries.size() || new_entries[j].path < old_entries[i].path) {
+			changed.emplace_back(new_entries[j].path);
+			++j;
+		} else {
+			if(std::memcmp(old_entries[i].hash->key, new_entries[j].hash->key, checksum_key::key_size) != 0)
+				changed.emplace_back(new_entries[j].path);
+			++i;
+			++j;
 		}
+	}
+	return changed;
+}
 
-		state.scenario_counter = header.count;
-		state.scenario_time_stamp = header.timestamp;
-		state.scenario_checksum = header.checksum;
+std::vector<char> read_scenario_input_manifest(native_string_view name) {
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	auto file = simple_fs::open_file(dir, scenario_input_manifest_name(name));
+	if(!file)
+		return std::vector<char>{};
+	auto content = simple_fs::view_contents(*file);
+	return std::vector<char>(content.data, content.data + content.file_size);
+}
 
-		state.loaded_save_file = NATIVE("");
-		state.loaded_scenario_file = name;
+void write_scenario_input_manifest(native_string_view name, std::vector<char> const& manifest) {
+	simple_fs::write_file(simple_fs::get_or_create_scenario_directory(), scenario_input_manifest_name(name), manifest.data(), uint32_t(manifest.size()));
+}
+
+namespace {
+
+struct compressed_section {
+	uint8_t const* data = nullptr;
+	uint32_t length = 0;
+	uint32_t decompressed_length = 0;
+};
+
+// finds the bounds of the next compressed section; nullptr if the file ends inside it
+uint8_t const* locate_section(uint8_t const* ptr_in, uint8_t const* file_end, compressed_section& out) {
+	if(ptr_in == nullptr || size_t(file_end - ptr_in) < sizeof(uint32_t) * 2)
+		return nullptr;
+	memcpy(&out.length, ptr_in, sizeof(uint32_t));
+	memcpy(&out.decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
+	out.data = ptr_in + sizeof(uint32_t) * 2;
+	if(size_t(file_end - out.data) < out.length)
+		return nullptr;
+	return out.data + out.length;
+}
 
-		buffer_pos = load_mod_path(buffer_pos, state);
+// shared by the sections of one load, which may decompress at the same time
+struct decompression_tracker {
+	load_progress* progress = nullptr;
+	std::atomic<uint64_t> produced = 0;
+	uint64_t total = 1;
 
-		buffer_pos = with_decompressed_section(buffer_pos,
-				[&](uint8_t const* ptr_in, uint32_t length) { read_scenario_section(ptr_in, ptr_in + length, state); });
-		buffer_pos = with_decompressed_section(buffer_pos,
-				[&](uint8_t const* ptr_in, uint32_t length) { read_save_section(ptr_in, ptr_in + length, state); });
+	void add(uint64_t bytes) {
+		auto done = produced.fetch_add(bytes, std::memory_order::relaxed) + bytes;
+		progress->report(load_stage::decompressing, float(done) / float(total));
+	}
+};
 
-		state.game_seed = uint32_t(std::random_device()());
+inline constexpr size_t decompression_step = 4 * 1024 * 1024;
 
-		state.on_scenario_load();
+bool decompress_section(compressed_section const& in, decompressed_section& out, decompression_tracker* tracker) {
+	out.data.reset(new uint8_t[in.decompressed_length]);
+	out.length = in.decompressed_length;
+	if(!tracker || !tracker->progress) {
+		auto result = ZSTD_decompress(out.data.get(), in.decompressed_length, in.data, in.length);
+		return !ZSTD_isError(result) && result == in.decompressed_length;
+	}
+
+	// in steps, so that progress is reported and a cancel request is honoured part way through
+	auto context = ZSTD_createDCtx();
+	ZSTD_inBuffer input{ in.data, in.length, 0 };
+	ZSTD_outBuffer output{ out.data.get(), 0, 0 };
+	size_t remaining = 1;
+	while(remaining != 0 && !tracker->progress->should_cancel()) {
+		auto output_before = output.pos;
+		auto input_before = input.pos;
+		output.size = std::min(size_t(in.decompressed_length), output.pos + decompression_step);
+		remaining = ZSTD_decompressStream(context, &output, &input);
+		if(ZSTD_isError(remaining))
+			break;
+		tracker->add(output.pos - output_before);
+		if(output.pos == output_before && input.pos == input_before) // truncated, or longer than its header says
+			break;
+	}
+	ZSTD_freeDCtx(context);
+	return remaining == 0 && output.pos == in.decompressed_length;
+}
 
+void report(load_progress* progress, load_stage stage, float fraction) {
+	if(progress)
+		progress->report(stage, fraction);
+}
+bool load_failed(load_progress* progress) {
+	report(progress, load_stage::failed, 0.0f);
+	return false;
+}
+bool load_cancelled(load_progress* progress) {
+	if(progress && progress->should_cancel()) {
+		report(progress, load_stage::cancelled, 0.0f);
 		return true;
-	} else {
-		return false;
 	}
+	return false;
 }
 
-bool try_read_scenario_as_save_file(sys::state& state, native_string_view name) {
-	auto dir = simple_fs::get_or_create_scenario_directory();
-	auto save_file = open_file(dir, name);
-	if(save_file) {
-		scenario_header header;
+}
+
+bool prepare_load(native_string_view name, load_kind kind, prepared_load& out, load_progress* progress) {
+	report(progress, load_stage::reading, 0.0f);
+
+	auto dir = kind == load_kind::save ? simple_fs::get_or_create_save_game_directory() : simple_fs::get_or_create_scenario_directory();
+	auto load_file = open_file(dir, name);
+	if(!load_file)
+		return load_failed(progress);
+
+	auto contents = simple_fs::view_contents(*load_file);
+	uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
+	auto file_end = buffer_pos + contents.file_size;
+
+	out.kind = kind;
+	out.name = native_string(name);
+
+	compressed_section scenario_section;
+	compressed_section save_section;
+	if(kind == load_kind::save) {
+		save_header header;
 		header.version = 0;
 
-		auto contents = simple_fs::view_contents(*save_file);
-		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
-		auto file_end = buffer_pos + contents.file_size;
+		if(contents.file_size > sizeof_save_header(header)) {
+			buffer_pos = read_save_header(buffer_pos, header);
+		}
+		if(header.version != sys::save_file_version) {
+			return load_failed(progress);
+		}
+
+		out.checksum = header.checksum;
+		out.scenario_counter = header.count;
+		out.scenario_time_stamp = header.timestamp;
+
+		buffer_pos = locate_section(buffer_pos, file_end, save_section);
+	} else {
+		scenario_header header;
+		header.version = 0;
 
 		if(contents.file_size > sizeof_scenario_header(header)) {
 			buffer_pos = read_scenario_header(buffer_pos, header);
 		}
-
 		if(header.version != sys::scenario_file_version) {
-			return false;
+			return load_failed(progress);
 		}
 
-		if(!state.scenario_checksum.is_equal(header.checksum))
-			return false;
+		out.checksum = header.checksum;
+		out.scenario_counter = header.count;
+		out.scenario_time_stamp = header.timestamp;
+
+		if(size_t(file_end - buffer_pos) < sizeof(uint32_t))
+			return load_failed(progress);
+		uint32_t mod_path_length = 0;
+		memcpy(&mod_path_length, buffer_pos, sizeof(uint32_t));
+		buffer_pos += sizeof(uint32_t);
+		if(size_t(file_end - buffer_pos) / sizeof(native_char) < mod_path_length)
+			return load_failed(progress);
+		out.mod_path = native_string(native_string_view(reinterpret_cast<native_char const*>(buffer_pos), mod_path_length));
+		buffer_pos += mod_path_length * sizeof(native_char);
+
+		buffer_pos = locate_section(buffer_pos, file_end, scenario_section);
+		if(kind != load_kind::scenario)
+			buffer_pos = locate_section(buffer_pos, file_end, save_section);
+	}
+	if(buffer_pos == nullptr)
+		return load_failed(progress);
+
+	// the sections are independent zstd frames, so both decompress at once. The apply reads the scenario and then the save
+	// section out of the prepared load, so both are held until then whichever way they are decompressed. A scenario loaded
+	// as a save never decompresses the scenario section it would only skip over
+	bool wants_scenario = kind == load_kind::scenario || kind == load_kind::scenario_and_save;
+	bool wants_save = kind != load_kind::scenario;
+	decompression_tracker tracker;
+	tracker.progress = progress;
+	tracker.total = std::max(uint64_t(1), uint64_t(wants_scenario ? scenario_section.decompressed_length : 0) + uint64_t(wants_save ? save_section.decompressed_length : 0));
+	bool scenario_ok = true;
+	bool save_ok = true;
+	if(wants_scenario && wants_save) {
+		concurrency::parallel_invoke(
+			[&]() { scenario_ok = decompress_section(scenario_section, out.scenario_section, &tracker); },
+			[&]() { save_ok = decompress_section(save_section, out.save_section, &tracker); });
+	} else if(wants_scenario) {
+		scenario_ok = decompress_section(scenario_section, out.scenario_section, &tracker);
+	} else {
+		save_ok = decompress_section(save_section, out.save_section, &tracker);
+	}
+	if(load_cancelled(progress))
+		return false;
+	if(!scenario_ok || !save_ok)
+		return load_failed(progress);
+
+	report(progress, load_stage::ready, 1.0f);
+	return true;
+}
+
+background_load::~background_load() {
+	if(worker.joinable()) {
+		cancel();
+		worker.join();
+	}
+}
+
+void background_load::start(native_string_view file_name, load_kind load_type) {
+	assert(!worker.joinable());
+	name = native_string(file_name);
+	kind = load_type;
+	load = prepared_load{};
+	prepared = false;
+	progress.cancel_requested.store(false, std::memory_order::release);
+	progress.report(load_stage::reading, 0.0f);
+	worker = std::thread([this]() { prepared = prepare_load(name, kind, load, &progress); });
+}
 
+bool background_load::done() const {
+	if(!worker.joinable())
+		return false;
+	auto stage = progress.stage.load(std::memory_order::acquire);
+	return stage == load_stage::ready || stage == load_stage::failed || stage == load_stage::cancelled;
+}
+
+void background_load::finish() {
+	if(worker.joinable())
+		worker.join();
+}
+
+bool apply_prepared_load(sys::state& state, prepared_load const& load) {
+	bool into_current_scenario = load.kind == load_kind::save || load.kind == load_kind::scenario_as_save;
+	if(into_current_scenario && !state.scenario_checksum.is_equal(load.checksum))
+		return false;
+
+	if(load.kind == load_kind::save) {
+		state.loaded_save_file = load.name;
+	} else {
+		if(!into_current_scenario) {
+			state.scenario_counter = load.scenario_counter;
+			state.scenario_time_stamp = load.scenario_time_stamp;
+			state.scenario_checksum = load.checksum;
+			state.loaded_scenario_file = load.name;
+		}
 		state.loaded_save_file = NATIVE("");
 
-		buffer_pos = load_mod_path(buffer_pos, state);
+		simple_fs::restore_state(state.common_fs, load.mod_path);
+		simple_fs::build_index(state.common_fs); // for the textures, sounds and so on that are loaded late
+	}
 
-		buffer_pos = with_decompressed_section(buffer_pos,
-			[&](uint8_t const* ptr_in, uint32_t length) {
-				// DO NOTHING -- this skips over reading the scenario section
-			});
-		buffer_pos = with_decompressed_section(buffer_pos,
-			[&](uint8_t const* ptr_in, uint32_t length) {
-				read_save_section(ptr_in, ptr_in + length, state);
-			});
+	if(load.scenario_section.data) {
+		auto ptr_in = load.scenario_section.data.get();
+		read_scenario_section(ptr_in, ptr_in + load.scenario_section.length, state);
+	}
+	if(load.save_section.data) {
+		auto ptr_in = load.save_section.data.get();
+		read_save_section(ptr_in, ptr_in + load.save_section.length, state);
+	}
 
+	if(load.kind == load_kind::scenario_and_save || load.kind == load_kind::scenario_as_save)
 		state.game_seed = uint32_t(std::random_device()());
+	if(load.kind == load_kind::scenario_and_save)
+		state.on_scenario_load();
 
-		return true;
-	} else {
+	return true;
+}
+
+bool try_read_scenario_file(sys::state& state, native_string_view name) {
+	prepared_load load;
+	if(!prepare_load(name, load_kind::scenario, load))
 		return false;
-	}
+	return apply_prepared_load(state, load);
+}
+
+bool try_read_scenario_and_save_file(sys::state& state, native_string_view name) {
+	prepared_load load;
+	if(!prepare_load(name, load_kind::scenario_and_save, load))
+		return false;
+	return apply_prepared_load(state, load);
+}
+
+bool try_read_scenario_as_save_file(sys::state& state, native_string_view name) {
+	prepared_load load;
+	if(!prepare_load(name, load_kind::scenario_as_save, load))
+		return false;
+	return apply_prepared_load(state, load);
 }
 
 std::string make_time_string(uint64_t value) {
@@ -1078,40 +1371,10 @@ void write_save_file(sys::state& state, save_type type, std::string const& name)
 	}
 }
 bool try_read_save_file(sys::state& state, native_string_view name) {
-	auto dir = simple_fs::get_or_create_save_game_directory();
-	auto save_file = open_file(dir, name);
-	if(save_file) {
-		save_header header;
-		header.version = 0;
-
-		auto contents = simple_fs::view_contents(*save_file);
-		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
-		auto file_end = buffer_pos + contents.file_size;
-
-		if(contents.file_size > sizeof_save_header(header)) {
-			buffer_pos = read_save_header(buffer_pos, header);
-		}
-
-		if(header.version != sys::save_file_version) {
-			return false;
-		}
-
-		//if(state.scenario_counter != header.count)
-		//	return false;
-		//if(state.scenario_time_stamp != header.timestamp)
-		//	return false;
-		if(!state.scenario_checksum.is_equal(header.checksum))
-			return false;
-
-		state.loaded_save_file = name;
-
-		buffer_pos = with_decompressed_section(buffer_pos,
-				[&](uint8_t const* ptr_in, uint32_t length) { read_save_section(ptr_in, ptr_in + length, state); });
-
-		return true;
-	} else {
+	prepared_load load;
+	if(!prepare_load(name, load_kind::save, load))
 		return false;
-	}
+	return apply_prepared_load(state, load);
 }
 
 } // namespace sys
@@ -1,5 +1,8 @@
 #pragma once
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
 #include "container_types.hpp"
 #include "unordered_dense.h"
 #include "text.hpp"
@@ -179,7 +182,6 @@ struct mod_identifier {
 };
 
 void read_mod_path(uint8_t const* ptr_in, uint8_t const* lim, native_string& path_out);
-uint8_t const* load_mod_path(uint8_t const* ptr_in, sys::state& state);
 uint8_t* write_mod_path(uint8_t* ptr_in, native_string const& path_in);
 size_t sizeof_mod_path(native_string const& path_in);
 
@@ -207,10 +209,93 @@ scenario_size sizeof_scenario_section(sys::state& state);
 size_t sizeof_save_section(sys::state& state);
 
 void write_scenario_file(sys::state& state, native_string_view name, uint32_t count);
+
+// progress of a load that is split into stages; written by the loading thread and polled by whoever wants to display it
+enum class load_stage : uint8_t {
+	idle, reading, decompressing, ready, cancelled, failed
+};
+struct load_progress {
+	std::atomic<load_stage> stage = load_stage::idle;
+	std::atomic<float> fraction = 0.0f; // of the reading and decompressing, 0 to 1
+	std::atomic<bool> cancel_requested = false;
+
+	void report(load_stage s, float f) {
+		fraction.store(f, std::memory_order::release);
+		stage.store(s, std::memory_order::release);
+	}
+	bool should_cancel() const {
+		return cancel_requested.load(std::memory_order::acquire);
+	}
+};
+
+struct decompressed_section {
+	std::unique_ptr<uint8_t[]> data;
+	uint32_t length = 0;
+};
+enum class load_kind : uint8_t {
+	scenario, scenario_and_save, scenario_as_save, save
+};
+// everything read from a scenario or save file before the state is touched
+struct prepared_load {
+	load_kind kind = load_kind::scenario;
+	native_string name;
+	checksum_key checksum;
+	uint32_t scenario_counter = 0;
+	uint64_t scenario_time_stamp = 0;
+	native_string mod_path;
+	decompressed_section scenario_section;
+	decompressed_section save_section;
+};
+
+// reads, validates and decompresses a file without touching the state, so it may run on any thread; returns false if the file is
+// missing, truncated or has the wrong version, or if the load was cancelled. Ends with progress in ready, failed or cancelled
+bool prepare_load(native_string_view name, load_kind kind, prepared_load& out, load_progress* progress = nullptr);
+// deserializes a prepared load into the state, which needs exclusive access to the world. Returns false, leaving the state
+// as it was, on a checksum mismatch. fill_unsaved_data is left to the caller, as before
+bool apply_prepared_load(sys::state& state, prepared_load const& load);
+
+// runs prepare_load on a worker thread; the owner polls done() and, once it is, calls finish() and applies the load itself
+class background_load {
+	std::thread worker;
+
+public:
+	native_string name;
+	load_kind kind = load_kind::save;
+	load_progress progress;
+	prepared_load load;  // only valid after finish()
+	bool prepared = false; // only valid after finish()
+
+	background_load() = default;
+	background_load(background_load const&) = delete;
+	background_load& operator=(background_load const&) = delete;
+	~background_load(); // cancels a running load and waits for it
+
+	void start(native_string_view file_name, load_kind load_type); // must not be active
+	bool active() const {
+		return worker.joinable();
+	}
+	bool done() const; // active and the worker has stopped reporting
+	void cancel() {
+		progress.cancel_requested.store(true, std::memory_order::release);
+	}
+	void finish(); // joins the worker
+};
+
 bool try_read_scenario_file(sys::state& state, native_string_view name);
 bool try_read_scenario_and_save_file(sys::state& state, native_string_view name);
 bool try_read_scenario_as_save_file(sys::state& state, native_string_view name);
 
+// content hashes of every file a scenario is built from, kept beside the scenario as <name>.inputs
+// the directories a scenario build parses, relative to the roots; an empty name stands for a whole root
+std::vector<native_string> const& scenario_input_directories();
+// files whose size and write time are unchanged from the previous manifest keep its hash without being read again
+std::vector<char> make_scenario_input_manifest(simple_fs::file_system const& fs, std::vector<char> const& previous = {},
+		std::vector<native_string> const& directories = scenario_input_directories());
+// the relative paths that were added, removed or changed; an unreadable old manifest reports a single empty path
+std::vector<std::string> changed_scenario_inputs(char const* old_data, size_t old_size, std::vector<char> const& current);
+std::vector<char> read_scenario_input_manifest(native_string_view name); // empty if there is none
+void write_scenario_input_manifest(native_string_view name, std::vector<char> const& manifest);
+
 void write_save_file(sys::state& state, sys::save_type type = sys::save_type::normal, std::string const& name = std::string(""));
 bool try_read_save_file(sys::state& state, native_string_view name);
 
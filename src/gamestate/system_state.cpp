@@ -470,7 +470,16 @@ void state::render() { // called to render the frame may (and should) delay retu
 	if(!current_scene.get_root)
 		return;
 
+	ogl::process_texture_uploads(*this);
+	ui::finish_save_load(*this);
+	++open_gl.flags.current_frame;
+
+	ui_snapshots.acquire();
+	auto dirty_channels = ui_dirty_channels.exchange(0, std::memory_order::acq_rel);
 	auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+	if(game_state_was_updated)
+		dirty_channels = ui::update_channel::all;
+	game_state_was_updated = game_state_was_updated || dirty_channels != 0;
 	if(game_state_was_updated && !current_scene.starting_scene && !ui_state.lazy_load_in_game) {
 		window::change_cursor(*this, window::cursor_type::busy);
 		ui::create_in_game_windows(*this);
@@ -667,35 +676,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 			auto* c6 = new_messages.front();
 			while(c6) {
 				auto base_type = c6->type;
-				auto setting_types = sys::message_setting_map[int32_t(base_type)];
-				uint8_t settings_bits = 0;
-				if(setting_types.source != sys::message_setting_type::count) {
-					if(c6->source == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.source)];
-					} else if(notification::nation_is_interesting(*this, c6->source)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.source)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.source)];
-					}
-				}
-				if(setting_types.target != sys::message_setting_type::count) {
-					if(c6->target == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.target)];
-					} else if(notification::nation_is_interesting(*this, c6->target)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.target)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.target)];
-					}
-				}
-				if(setting_types.third != sys::message_setting_type::count) {
-					if(c6->third == local_player_nation) {
-						settings_bits |= user_settings.self_message_settings[int32_t(setting_types.third)];
-					} else if(notification::nation_is_interesting(*this, c6->third)) {
-						settings_bits |= user_settings.interesting_message_settings[int32_t(setting_types.third)];
-					} else {
-						settings_bits |= user_settings.other_message_settings[int32_t(setting_types.third)];
-					}
-				}
+				auto settings_bits = notification::message_settings(*this, base_type, c6->source, c6->target, c6->third);
 
 				if((settings_bits & message_response::log) && ui_state.msg_log_window) {
 					static_cast<ui::message_log_window*>(ui_state.msg_log_window)->messages.push_back(*c6);
@@ -805,7 +786,9 @@ void state::render() { // called to render the frame may (and should) delay retu
 				ui_state.root->move_child_to_front(ui_state.msg_window);
 			}
 		}
+		ui_state.update_channels = dirty_channels;
 		root_elm->impl_on_update(*this);
+		ui_state.update_channels = ui::update_channel::all;
 
 		current_scene.on_game_state_update_update_ui(*this);
 
@@ -1307,6 +1290,157 @@ void state::load_locale_strings(std::string_view locale_name) {
 	}
 }
 
+namespace {
+
+struct locale_pack_header {
+	static constexpr uint32_t current_version = 1;
+
+	uint32_t version = current_version;
+	uint32_t entry_count = 0;
+	uint32_t key_bytes = 0;
+	uint32_t text_bytes = 0;
+	checksum_key sources;
+};
+
+struct locale_pack_entry {
+	uint32_t key_offset = 0; // into the key block
+	uint32_t text_offset = 0; // into the text block, which becomes locale_text_data as is
+};
+
+native_string locale_pack_name(native_string_view scenario_file, std::string_view locale_name) {
+	return native_string(scenario_file.empty() ? NATIVE("default") : scenario_file) + NATIVE("_") + simple_fs::utf8_to_native(locale_name) + NATIVE(".loc");
+}
+
+} // namespace
+
+checksum_key state::locale_sources_checksum(std::string_view fallback_name, std::string_view locale_name) {
+	// the names and contents of every csv file load_locale_strings could read; hashing is still far cheaper than parsing them
+	blake2b_state hash_state;
+	blake2b_init(&hash_state, sizeof(checksum_key));
+	auto add_name = [&](std::string_view name) {
+		blake2b_update(&hash_state, name.data(), name.size());
+		char const separator = 0;
+		blake2b_update(&hash_state, &separator, 1);
+	};
+	add_name(fallback_name);
+	add_name(locale_name);
+
+	auto add_directory = [&](simple_fs::directory const& dir) {
+		for(auto& file : list_files(dir, NATIVE(".csv"))) {
+			add_name(simple_fs::native_to_utf8(get_full_name(file)));
+			if(auto ofile = open_file(file); ofile) {
+				auto content = view_contents(*ofile);
+				uint64_t size = content.file_size;
+				blake2b_update(&hash_state, &size, sizeof(size));
+				blake2b_update(&hash_state, content.data, content.file_size);
+			}
+		}
+	};
+	auto root_dir = get_root(common_fs);
+	auto assets_dir = open_directory(root_dir, NATIVE("assets/localisation"));
+	add_directory(open_directory(root_dir, NATIVE("localisation")));
+	add_directory(assets_dir);
+	if(!fallback_name.empty())
+		add_directory(open_directory(assets_dir, simple_fs::utf8_to_native(fallback_name)));
+	add_directory(open_directory(assets_dir, simple_fs::utf8_to_native(locale_name)));
+
+	checksum_key key;
+	blake2b_final(&hash_state, &key, sizeof(key));
+	return key;
+}
+
+std::vector<char> state::write_locale_pack(checksum_key const& sources) const {
+	// only the strings still reachable from a key are kept; csv files overriding each other leave dead strings behind in the pool
+	std::vector<locale_pack_entry> entries;
+	std::vector<char> keys;
+	std::vector<char> text;
+	entries.reserve(locale_key_to_text_sequence.size());
+	text.push_back(0); // as in reset_locale_pool, offset 0 is the empty string
+	for(auto& [key, text_offset] : locale_key_to_text_sequence) {
+		if(!key)
+			continue;
+		auto key_sv = to_string_view(key);
+		auto text_sv = locale_string_view(text_offset);
+		entries.push_back(locale_pack_entry{ uint32_t(keys.size()), text_sv.empty() ? 0 : uint32_t(text.size()) });
+		keys.insert(keys.end(), key_sv.begin(), key_sv.end());
+		keys.push_back(0);
+		if(!text_sv.empty()) {
+			text.insert(text.end(), text_sv.begin(), text_sv.end());
+			text.push_back(0);
+		}
+	}
+
+	locale_pack_header header;
+	header.entry_count = uint32_t(entries.size());
+	header.key_bytes = uint32_t(keys.size());
+	header.text_bytes = uint32_t(text.size());
+	header.sources = sources;
+
+	std::vector<char> result(sizeof(header) + entries.size() * sizeof(locale_pack_entry) + keys.size() + text.size());
+	auto out = result.data();
+	std::memcpy(out, &header, sizeof(header));
+	out += sizeof(header);
+	if(!entries.empty())
+		std::memcpy(out, entries.data(), entries.size() * sizeof(locale_pack_entry));
+	out += entries.size() * sizeof(locale_pack_entry);
+	if(!keys.empty())
+		std::memcpy(out, keys.data(), keys.size());
+	out += keys.size();
+	std::memcpy(out, text.data(), text.size());
+	return result;
+}
+
+bool state::read_locale_pack(char const* data, uint32_t size, checksum_key const& sources) {
+	locale_pack_header header;
+	if(size < sizeof(header))
+		return false;
+	std::memcpy(&header, data, sizeof(header));
+	if(header.version != locale_pack_header::current_version || !header.sources.is_equal(sources))
+		return false;
+	auto entries_size = uint64_t(header.entry_count) * sizeof(locale_pack_entry);
+	if(uint64_t(size) != sizeof(header) + entries_size + header.key_bytes + header.text_bytes || header.text_bytes == 0)
+		return false;
+
+	auto entries = data + sizeof(header);
+	auto keys = entries + entries_size;
+	auto text = keys + header.key_bytes;
+	if((header.key_bytes != 0 && keys[header.key_bytes - 1] != 0) || text[header.text_bytes - 1] != 0)
+		return false;
+	for(uint32_t i = 0; i < header.entry_count; ++i) {
+		locale_pack_entry e;
+		std::memcpy(&e, entries + i * sizeof(locale_pack_entry), sizeof(e));
+		if(e.key_offset >= header.key_bytes || e.text_offset >= header.text_bytes)
+			return false;
+	}
+
+	// the text block is the finished pool; only the keys need to be (re)registered and hashed
+	locale_text_data.assign(text, text + header.text_bytes);
+	locale_key_to_text_sequence.clear();
+	locale_key_to_text_sequence.reserve(header.entry_count);
+	for(uint32_t i = 0; i < header.entry_count; ++i) {
+		locale_pack_entry e;
+		std::memcpy(&e, entries + i * sizeof(locale_pack_entry), sizeof(e));
+		auto key = add_key_utf8(std::string_view(keys + e.key_offset));
+		locale_key_to_text_sequence.insert_or_assign(key, e.text_offset);
+	}
+	return true;
+}
+
+bool state::load_locale_pack(std::string_view locale_name, checksum_key const& sources) {
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	auto file = simple_fs::open_file(dir, locale_pack_name(loaded_scenario_file, locale_name));
+	if(!file)
+		return false;
+	auto content = simple_fs::view_contents(*file);
+	return read_locale_pack(content.data, content.file_size, sources);
+}
+
+void state::save_locale_pack(std::string_view locale_name, checksum_key const& sources) const {
+	auto pack = write_locale_pack(sources);
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	simple_fs::write_file(dir, locale_pack_name(loaded_scenario_file, locale_name), pack.data(), uint32_t(pack.size()));
+}
+
 bool state::key_is_localized(dcon::text_key tag) const {
 	if(!tag)
 		return false;
@@ -1446,6 +1580,63 @@ std::string_view state::to_string_view(dcon::unit_name_id tag) const {
 	return std::string_view(unit_names.data() + unit_names_indices[tag.index()], size_t(end_position - start_position));
 }
 
+namespace {
+
+uint64_t bytecode_hash(uint16_t const* data, size_t size) {
+	return ankerl::unordered_dense::detail::wyhash::hash(data, size * sizeof(uint16_t));
+}
+
+int32_t find_interned_block(bytecode_intern_table const& table, std::vector<uint16_t> const& storage, std::vector<uint16_t> const& data) {
+	auto it = table.blocks.find(bytecode_hash(data.data(), data.size()));
+	if(it == table.blocks.end())
+		return -1;
+	for(auto offset : it->second) {
+		// the stored offsets are verified against the live data, so a hash collision can never return a wrong block
+		if(size_t(offset) + data.size() <= storage.size() && std::equal(data.begin(), data.end(), storage.data() + offset))
+			return offset;
+	}
+	return -1;
+}
+
+void intern_block(bytecode_intern_table& table, uint16_t const* base, uint16_t const* block, int32_t size) {
+	auto& offsets = table.blocks[bytecode_hash(block, size_t(size))];
+	auto offset = int32_t(block - base);
+	if(std::find(offsets.begin(), offsets.end(), offset) == offsets.end())
+		offsets.push_back(offset);
+}
+
+void intern_trigger(bytecode_intern_table& table, std::vector<uint16_t>& storage, int32_t start) {
+	auto base = storage.data();
+	trigger::recurse_over_triggers(base + start, [&](uint16_t* tval) {
+		intern_block(table, base, tval, 1 + trigger::get_trigger_payload_size(tval));
+	});
+}
+
+void intern_effect(bytecode_intern_table& table, std::vector<uint16_t>& storage, int32_t start) {
+	auto base = storage.data();
+	effect::recurse_over_effects(base + start, [&](uint16_t* eval) {
+		intern_block(table, base, eval, 1 + effect::get_generic_effect_payload_size(eval));
+	});
+}
+
+// registers the keys committed (or loaded) since the last call; entry 0 of the indices is the invalid placeholder
+// only a whole new trigger / effect can be matched: one that equals an existing key or a block nested inside one reuses that
+// storage, but the blocks nested inside new bytecode are always appended as they are, since a key must be contiguous
+template<typename F>
+void index_committed_keys(bytecode_intern_table& table, std::vector<uint16_t>& storage, std::vector<int32_t> const& indices, F&& intern) {
+	if(table.indexed_keys > indices.size())
+		table.clear();
+	if(table.indexed_keys == 0)
+		table.indexed_keys = 1;
+	for(; table.indexed_keys < indices.size(); ++table.indexed_keys) {
+		auto start = indices[table.indexed_keys];
+		table.keys.try_emplace(start, int32_t(table.indexed_keys)); // the first key at an offset wins, as before
+		intern(table, storage, start);
+	}
+}
+
+}
+
 dcon::trigger_key state::commit_trigger_data(std::vector<uint16_t> data) {
 	if(trigger_data_indices.empty()) { // Create placeholder for invalid triggers
 		trigger_data_indices.push_back(0);
@@ -1456,28 +1647,21 @@ dcon::trigger_key state::commit_trigger_data(std::vector<uint16_t> data) {
 		return dcon::trigger_key();
 	}
 
-	auto search_result = std::search(trigger_data.data() + 1, trigger_data.data() + trigger_data.size(),
-			std::boyer_moore_horspool_searcher(data.data(), data.data() + data.size()));
-	if(search_result != trigger_data.data() + trigger_data.size()) {
-		auto const start = search_result - trigger_data.data();
-		auto it = std::find(trigger_data_indices.begin(), trigger_data_indices.end(), int32_t(start));
-		if(it != trigger_data_indices.end()) {
-			auto d = std::distance(trigger_data_indices.begin(), it);
-			return dcon::trigger_key(dcon::trigger_key::value_base_t(d - 1));
-		} else {
-			trigger_data_indices.push_back(int32_t(start));
-			assert(trigger_data_indices.size() <= std::numeric_limits<uint16_t>::max());
-			return dcon::trigger_key(dcon::trigger_key::value_base_t(trigger_data_indices.size() - 1 - 1));
+	index_committed_keys(trigger_data_interned, trigger_data, trigger_data_indices, intern_trigger);
+
+	auto start = find_interned_block(trigger_data_interned, trigger_data, data);
+	if(start != -1) {
+		if(auto it = trigger_data_interned.keys.find(start); it != trigger_data_interned.keys.end()) {
+			return dcon::trigger_key(dcon::trigger_key::value_base_t(it->second - 1));
 		}
 	} else {
-		auto start = trigger_data.size();
-		auto size = data.size();
-		trigger_data.resize(start + size, uint16_t(0));
-		std::copy_n(data.data(), size, trigger_data.data() + start);
-		trigger_data_indices.push_back(int32_t(start));
-		assert(trigger_data_indices.size() <= std::numeric_limits<uint16_t>::max());
-		return dcon::trigger_key(dcon::trigger_key::value_base_t(trigger_data_indices.size() - 1 - 1));
+		start = int32_t(trigger_data.size());
+		trigger_data.insert(trigger_data.end(), data.begin(), data.end());
 	}
+	trigger_data_indices.push_back(start);
+	assert(trigger_data_indices.size() <= std::numeric_limits<uint16_t>::max());
+	index_committed_keys(trigger_data_interned, trigger_data, trigger_data_indices, intern_trigger);
+	return dcon::trigger_key(dcon::trigger_key::value_base_t(trigger_data_indices.size() - 1 - 1));
 }
 
 dcon::effect_key state::commit_effect_data(std::vector<uint16_t> data) {
@@ -1490,28 +1674,21 @@ dcon::effect_key state::commit_effect_data(std::vector<uint16_t> data) {
 		return dcon::effect_key();
 	}
 
-	auto search_result = std::search(effect_data.data() + 1, effect_data.data() + effect_data.size(),
-			std::boyer_moore_horspool_searcher(data.data(), data.data() + data.size()));
-	if(search_result != effect_data.data() + effect_data.size()) {
-		auto const start = search_result - effect_data.data();
-		auto it = std::find(effect_data_indices.begin(), effect_data_indices.end(), int32_t(start));
-		if(it != effect_data_indices.end()) {
-			auto d = std::distance(effect_data_indices.begin(), it);
-			return dcon::effect_key(dcon::effect_key::value_base_t(d - 1));
-		} else {
-			effect_data_indices.push_back(int32_t(start));
-			assert(effect_data_indices.size() <= std::numeric_limits<uint16_t>::max());
-			return dcon::effect_key(dcon::effect_key::value_base_t(effect_data_indices.size() - 1 - 1));
+	index_committed_keys(effect_data_interned, effect_data, effect_data_indices, intern_effect);
+
+	auto start = find_interned_block(effect_data_interned, effect_data, data);
+	if(start != -1) {
+		if(auto it = effect_data_interned.keys.find(start); it != effect_data_interned.keys.end()) {
+			return dcon::effect_key(dcon::effect_key::value_base_t(it->second - 1));
 		}
 	} else {
-		auto start = effect_data.size();
-		auto size = data.size();
-		effect_data.resize(start + size, uint16_t(0));
-		std::copy_n(data.data(), size, effect_data.data() + start);
-		effect_data_indices.push_back(int32_t(start));
-		assert(effect_data_indices.size() <= std::numeric_limits<uint16_t>::max());
-		return dcon::effect_key(dcon::effect_key::value_base_t(effect_data_indices.size() - 1 - 1));
+		start = int32_t(effect_data.size());
+		effect_data.insert(effect_data.end(), data.begin(), data.end());
 	}
+	effect_data_indices.push_back(start);
+	assert(effect_data_indices.size() <= std::numeric_limits<uint16_t>::max());
+	index_committed_keys(effect_data_interned, effect_data, effect_data_indices, intern_effect);
+	return dcon::effect_key(dcon::effect_key::value_base_t(effect_data_indices.size() - 1 - 1));
 }
 
 void state::save_user_settings() const {
@@ -1779,9 +1956,14 @@ void state::open_diplomacy(dcon::nation_id target) {
 }
 
 void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day bookmark_date) {
+	simple_fs::build_index(common_fs); // the roots are final by now, and every file below is looked up through all of them
 	auto root = get_root(common_fs);
 	auto common = open_directory(root, NATIVE("common"));
 
+	// offsets remembered from an earlier build would point into bytecode that no longer exists
+	trigger_data_interned.clear();
+	effect_data_interned.clear();
+
 	parsers::scenario_building_context context(*this);
 
 	//text::name_into_font_id(*this, "garamond_14");
@@ -3341,6 +3523,12 @@ void state::on_scenario_load() {
 	world.pop_type_resize_ideology_fns(world.ideology_size());
 	world.pop_type_resize_promotion_fns(world.pop_type_size());
 
+	// must happen before the triggers are compiled below
+	if(defines.alice_reorder_trigger_clauses > 0.0f) {
+		trigger::load_clause_statistics(*this);
+		trigger::reorder_trigger_clauses(*this);
+	}
+
 	if(network_mode != network_mode_type::single_player)
 		return;
 
@@ -3654,6 +3842,8 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	world.nation_resize_active_building(world.factory_type_size());
 	world.nation_resize_unit_stats(uint32_t(military_definitions.unit_base_definitions.size()));
 	world.nation_resize_max_building_level(economy::max_building_types);
+	world.nation_resize_potential_decisions(world.decision_size());
+	world.nation_resize_allowed_decisions(world.decision_size());
 
 	world.province_resize_modifier_values(provincial_mod_offsets::count);
 
@@ -3722,7 +3912,7 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	culture::restore_unsaved_values(*this);
 	nations::restore_state_instances(*this);
 	demographics::regenerate_from_pop_data_full(*this);
-	demographics::alt_regenerate_from_pop_data_full(*this);
+	alt_demographics_out_of_date = true;
 
 	sys::repopulate_modifier_effects(*this);
 	military::restore_unsaved_values(*this);
@@ -3814,14 +4004,15 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	province::update_cached_values(*this);
 	nations::update_cached_values(*this);
 
-	ai::identify_focuses(*this);
-	ai::initialize_ai_tech_weights(*this);
-	ai::update_ai_general_status(*this);
-	ai::refresh_home_ports(*this);
+	// read only by the ai during a tick, so they wait for the first one; home ports are refreshed at the start of every tick anyway
+	ai_cached_values_out_of_date = true;
+	ai::update_ai_general_status(*this); // also read by the diplomacy ui
 
 	military_definitions.pending_blackflag_update = true;
 	military::update_blackflag_status(*this);
 
+	nations::update_decision_availability(*this);
+
 
 
 
@@ -3874,9 +4065,40 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 
 #endif // ! NDEBUG
 
+	publish_ui_snapshot();
 	game_state_updated.store(true, std::memory_order::release);
 }
 
+void state::publish_ui_snapshot() {
+	auto& s = ui_snapshots.back();
+	s.date = current_date;
+
+	s.nations.resize(world.nation_size());
+	for(auto n : world.in_nation) {
+		auto& v = s.nations[n.id.index()];
+		auto total = n.get_demographics(demographics::total);
+		v.prestige = nations::prestige_score(*this, n);
+		v.industrial_score = n.get_industrial_score();
+		v.military_score = n.get_military_score();
+		v.population = total;
+		v.literacy = n.get_demographics(demographics::literacy) / std::max(1.0f, total);
+		v.infamy = n.get_infamy();
+		v.treasury = nations::get_treasury(*this, n);
+		v.rank = n.get_rank();
+		v.owned_provinces = n.get_owned_province_count();
+		v.status = nations::get_status(*this, n);
+	}
+
+	s.province_owner.resize(world.province_size());
+	s.province_controller.resize(world.province_size());
+	for(auto p : world.in_province) {
+		s.province_owner[p.id.index()] = p.get_nation_from_province_ownership();
+		s.province_controller[p.id.index()] = p.get_nation_from_province_control();
+	}
+
+	ui_snapshots.publish();
+}
+
 void state::single_game_tick() {
 	// do update logic
 
@@ -3890,6 +4112,11 @@ void state::single_game_tick() {
 
 	auto ymd_date = current_date.to_ymd(start_date);
 
+	// data left out of date by fill_unsaved_data
+	ai::update_cached_values(*this);
+	if(network_mode == network_mode_type::single_player) // only the single player tick swaps the alt store in
+		demographics::update_alt_demographics(*this);
+
 	diplomatic_message::update_pending(*this);
 
 	auto month_start = sys::year_month_day{ ymd_date.year, ymd_date.month, uint16_t(1) };
@@ -4185,6 +4412,8 @@ void state::single_game_tick() {
 			ai::update_ships(*this);
 		}
 
+		nations::update_decision_availability(*this); // read by ai::take_ai_decisions below and by the ui
+
 		// Once per month updates, spread out over the month
 		switch(ymd_date.day) {
 		case 1:
@@ -4427,7 +4656,10 @@ void state::single_game_tick() {
 
 	ui_date = current_date;
 
-	game_state_updated.store(true, std::memory_order::release);
+	publish_ui_snapshot();
+	// economy, demographics, research, movement and influence write to every game channel each day, so a tick marks all of them;
+	// the channels only keep ui-side changes such as the unit selection from rebuilding unrelated windows
+	mark_ui_dirty(ui::update_channel::game_tick);
 
 	switch(user_settings.autosaves) {
 	case autosave_frequency::none:
@@ -4570,7 +4802,7 @@ void state::new_army_group(dcon::province_id hq) {
 	world.automated_army_group_set_hq(new_group, hq);
 	world.automated_army_group_set_owner(new_group, local_player_nation);
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 }
 
 void state::toggle_defensive_position(dcon::automated_army_group_id group, dcon::province_id position) {
@@ -4582,7 +4814,7 @@ void state::toggle_defensive_position(dcon::automated_army_group_id group, dcon:
 		fat_group.get_provinces_defend().push_back(position);
 	}
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 	map_state.unhandled_province_selection = true;
 }
 
@@ -4595,7 +4827,7 @@ void state::toggle_enforce_control_position(dcon::automated_army_group_id group,
 		fat_group.get_provinces_enforce_control().push_back(position);
 	}
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 	map_state.unhandled_province_selection = true;
 }
 
@@ -4612,7 +4844,7 @@ void state::toggle_designated_port(dcon::automated_army_group_id group, dcon::pr
 		fat_group.get_provinces_ferry_origin().push_back(position);
 	}
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 	map_state.unhandled_province_selection = true;
 }
 
@@ -4651,7 +4883,7 @@ void state::army_group_add_regiment(dcon::automated_army_group_id group, dcon::r
 	command::mark_regiments_to_split(*this, local_player_nation, data);
 	command::split_army(*this, local_player_nation, army);
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 }
 
 void state::remove_navy_from_army_group(dcon::automated_army_group_id selected_group, dcon::navy_id navy_to_delete) {
@@ -4709,7 +4941,7 @@ void state::add_navy_to_army_group(dcon::automated_army_group_id selected_group,
 		auto new_link = world.try_create_automated_army_group_membership_navy(selected_navy, selected_group);
 	}
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 }
 
 void state::delete_army_group(dcon::automated_army_group_id group) {
@@ -4730,7 +4962,7 @@ void state::delete_army_group(dcon::automated_army_group_id group) {
 	}
 
 	world.delete_automated_army_group(group);
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::military | ui::update_channel::selection);
 }
 
 void state::update_armies_and_fleets(dcon::automated_army_group_id group) {
@@ -4778,13 +5010,13 @@ void state::smart_select_army_group(dcon::automated_army_group_id selected_group
 void state::select_army_group(dcon::automated_army_group_id selected_group) {
 	selected_army_group = selected_group;
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::selection);
 }
 
 void state::deselect_army_group() {
 	selected_army_group = {};
 
-	game_state_updated.store(true, std::memory_order_release);
+	mark_ui_dirty(ui::update_channel::selection);
 }
 
 dcon::regiment_automation_data_id state::fill_province_up_to_supply_limit(
@@ -5681,7 +5913,7 @@ void selected_regiments_add(sys::state& state, dcon::regiment_id reg) {
 			break;
 		}
 	}
-	state.game_state_updated.store(true, std::memory_order_release);
+	state.mark_ui_dirty(ui::update_channel::selection);
 }
 void selected_regiments_clear(sys::state& state) {
 	for(unsigned i = 0; i < state.selected_regiments.size(); i++) {
@@ -5691,7 +5923,7 @@ void selected_regiments_clear(sys::state& state) {
 			break;
 		}
 	}
-	state.game_state_updated.store(true, std::memory_order_release);
+	state.mark_ui_dirty(ui::update_channel::selection);
 }
 
 void selected_ships_add(sys::state& state, dcon::ship_id sh) {
@@ -5707,7 +5939,7 @@ void selected_ships_add(sys::state& state, dcon::ship_id sh) {
 			break;
 		}
 	}
-	state.game_state_updated.store(true, std::memory_order_release);
+	state.mark_ui_dirty(ui::update_channel::selection);
 }
 void selected_ships_clear(sys::state& state) {
 	for(unsigned i = 0; i < state.selected_ships.size(); i++) {
@@ -5717,7 +5949,7 @@ void selected_ships_clear(sys::state& state) {
 			break;
 }
 	}
-	state.game_state_updated.store(true, std::memory_order_release);
+	state.mark_ui_dirty(ui::update_channel::selection);
 }
 
 } // namespace sys
@@ -24,6 +24,7 @@
 #include "defines.hpp"
 #include "province.hpp"
 #include "events.hpp"
+#include "triggers.hpp"
 #include "SPSCQueue.h"
 #include "commands.hpp"
 #include "diplomatic_messages.hpp"
@@ -32,6 +33,7 @@
 #include "network.hpp"
 #include "fif.hpp"
 #include "immediate_mode.hpp"
+#include "serialization.hpp"
 
 // this header will eventually contain the highest-level objects
 // that represent the overall state of the program
@@ -466,6 +468,77 @@ struct player_data { // currently this data is serialized via memcpy, to make su
 	std::array<float, 32> population_record = { 0.0f }; // current day's value = date.value & 31
 };
 
+// values the ui shows for every nation (ledger, topbar, outliner, map modes), copied out of the world at the end of each tick
+struct nation_snapshot {
+	float prestige = 0.0f; // nations::prestige_score
+	float industrial_score = 0.0f;
+	float military_score = 0.0f;
+	float population = 0.0f;
+	float literacy = 0.0f; // fraction of the population
+	float infamy = 0.0f;
+	float treasury = 0.0f;
+	uint16_t rank = 0;
+	uint16_t owned_provinces = 0;
+	nations::status status = nations::status::primitive;
+};
+
+struct ui_snapshot {
+	sys::date date;
+	std::vector<nation_snapshot> nations;
+	std::vector<dcon::nation_id> province_owner;
+	std::vector<dcon::nation_id> province_controller;
+
+	nation_snapshot const& nation(dcon::nation_id n) const {
+		static nation_snapshot const none;
+		return n && uint32_t(n.index()) < nations.size() ? nations[n.index()] : none;
+	}
+	dcon::nation_id owner(dcon::province_id p) const {
+		return p && uint32_t(p.index()) < province_owner.size() ? province_owner[p.index()] : dcon::nation_id{};
+	}
+	dcon::nation_id controller(dcon::province_id p) const {
+		return p && uint32_t(p.index()) < province_controller.size() ? province_controller[p.index()] : dcon::nation_id{};
+	}
+};
+
+// lock free triple buffer: the game thread fills one snapshot while the ui reads another, and neither side ever waits
+class ui_snapshot_buffer {
+	static constexpr uint8_t fresh_bit = 4;
+
+	std::array<ui_snapshot, 3> snapshots;
+	std::atomic<uint8_t> middle = 1;
+	uint8_t write_index = 0; // owned by the publishing (game) thread
+	uint8_t read_index = 2; // owned by the ui thread
+public:
+	ui_snapshot& back() {
+		return snapshots[write_index];
+	}
+	void publish() {
+		write_index = uint8_t(middle.exchange(uint8_t(write_index | fresh_bit), std::memory_order_acq_rel) & 3);
+	}
+	// called once at the start of a frame, so that everything drawn in that frame agrees
+	void acquire() {
+		if((middle.load(std::memory_order_acquire) & fresh_bit) != 0)
+			read_index = uint8_t(middle.exchange(read_index, std::memory_order_acq_rel) & 3);
+	}
+	ui_snapshot const& front() const {
+		return snapshots[read_index];
+	}
+};
+
+// hash-consing table used when committing trigger / effect bytecode; it is only needed while building a scenario and is not saved
+// it is cleared at the start of every scenario build
+struct bytecode_intern_table {
+	ankerl::unordered_dense::map<uint64_t, std::vector<int32_t>> blocks; // content hash -> offsets of the blocks (whole triggers and their sub-triggers) with that hash
+	ankerl::unordered_dense::map<int32_t, int32_t> keys; // offset -> position in the indices vector
+	size_t indexed_keys = 0; // how many entries of the indices vector have been registered
+
+	void clear() {
+		blocks.clear();
+		keys.clear();
+		indexed_keys = 0;
+	}
+};
+
 // the state struct will eventually include (at least pointers to)
 // the state of the sound system, the state of the windowing system,
 // and the game data / state itself
@@ -494,6 +567,11 @@ struct alignas(64) state {
 	std::vector<int32_t> trigger_data_indices;
 	std::vector<uint16_t> effect_data;
 	std::vector<int32_t> effect_data_indices;
+	bytecode_intern_table trigger_data_interned;
+	bytecode_intern_table effect_data_interned;
+	trigger::clause_statistics trigger_clause_statistics;
+	trigger::script_profiler script_profile;
+	trigger::memo_cache trigger_memo;
 	std::vector<value_modifier_segment> value_modifier_segments;
 	tagged_vector<value_modifier_description, dcon::value_modifier_key> value_modifiers;
 
@@ -505,6 +583,8 @@ struct alignas(64) state {
 	bool adjacency_data_out_of_date = true;
 	bool national_cached_values_out_of_date = false;
 	bool diplomatic_cached_values_out_of_date = false;
+	bool alt_demographics_out_of_date = false; // the alt store is only read by the single player tick, so it is filled then; stays set in multiplayer
+	bool ai_cached_values_out_of_date = false;
 	std::vector<dcon::nation_id> nations_by_rank;
 	std::vector<dcon::nation_id> nations_by_industrial_score;
 	std::vector<dcon::nation_id> nations_by_military_score;
@@ -518,6 +598,7 @@ struct alignas(64) state {
 	sys::checksum_key session_host_checksum;// for checking that the client can join a session
 	native_string loaded_scenario_file;
 	native_string loaded_save_file;
+	sys::background_load save_load; // started by the save picker, polled and applied by the ui thread in render
 
 #ifdef USE_LLVM
 	std::unique_ptr<fif::environment> jit_environment;
@@ -571,6 +652,8 @@ struct alignas(64) state {
 
 	ui::definitions ui_defs; // definitions for graphics and ui
 
+	modifier_ledger applied_modifiers; // which modifiers are folded into the modifier values of nations and provinces
+
 	std::vector<uint8_t> flag_type_map;   // flag_type remapper for saving space while also allowing mods to add flags not present in vanilla
 	std::vector<culture::flag_type> flag_types; // List of unique flag types
 
@@ -587,12 +670,14 @@ struct alignas(64) state {
 	//
 
 	network_mode_type network_mode = network_mode_type::single_player;
+	bool headless = false; // no window will ever be created, so nothing consumes ui messages
 	dcon::nation_id local_player_nation;
 	sys::date current_date = sys::date{0};
 	sys::date ui_date = sys::date{0};
 	uint32_t game_seed = 0; // do *not* alter this value, ever
 	float inflation = 1.0f;
 	player_data player_data_cache;
+	ui_snapshot_buffer ui_snapshots;
 	std::vector<dcon::army_id> selected_armies;
 	std::vector<dcon::regiment_id> selected_regiments; // selected regiments inside the army
 
@@ -626,6 +711,7 @@ struct alignas(64) state {
 
 	// synchronization data (between main update logic and ui thread)
 	std::atomic<bool> game_state_updated = false;                    // game state -> ui signal
+	std::atomic<uint32_t> ui_dirty_channels = 0;                     // game state -> ui signal, limited to some ui::update_channel bits
 	std::atomic<bool> province_ownership_changed = true;                    // game state -> ui signal
 	std::atomic<bool> save_list_updated = false;                     // game state -> ui signal
 	std::atomic<bool> quit_signaled = false;                         // ui -> game state signal
@@ -728,6 +814,13 @@ struct alignas(64) state {
 
 	void reset_locale_pool();
 	void load_locale_strings(std::string_view locale_name);
+	// a locale pack is the compacted result of loading a locale (and its fallback) from csv files: the key and text tables,
+	// stamped with a checksum of the csv files that produced it so that a stale pack is rebuilt rather than used
+	checksum_key locale_sources_checksum(std::string_view fallback_name, std::string_view locale_name);
+	std::vector<char> write_locale_pack(checksum_key const& sources) const;
+	bool read_locale_pack(char const* data, uint32_t size, checksum_key const& sources); // false leaves the locale pool untouched
+	bool load_locale_pack(std::string_view locale_name, checksum_key const& sources);
+	void save_locale_pack(std::string_view locale_name, checksum_key const& sources) const;
 
 	dcon::text_key add_key_win1252(std::string const& text);
 	dcon::text_key add_key_win1252(std::string_view text);
@@ -757,6 +850,10 @@ struct alignas(64) state {
 
 	void load_scenario_data(parsers::error_handler& err, sys::year_month_day bookmark_date);   // loads all scenario files other than map data
 	void fill_unsaved_data();    // reconstructs derived values that are not directly saved after a save has been loaded
+	void publish_ui_snapshot();  // copies the values in ui_snapshot out of the world and hands them to the ui
+	void mark_ui_dirty(uint32_t channels) { // like setting game_state_updated, but only the ui elements reading from channels are updated
+		ui_dirty_channels.fetch_or(channels, std::memory_order_release);
+	}
 	void on_scenario_load(); // called when the scenario file is loaded (not when saves are loaded)
 	void preload(); // clears data that will be later reconstructed from saved values
 
@@ -774,13 +871,13 @@ struct alignas(64) state {
 	void select(dcon::army_id a) {
 		if(!is_selected(a)) {
 			selected_armies.push_back(a);
-			game_state_updated.store(true, std::memory_order_release);
+			mark_ui_dirty(ui::update_channel::selection);
 		}
 	}
 	void select(dcon::navy_id a) {
 		if(!is_selected(a)) {
 			selected_navies.push_back(a);
-			game_state_updated.store(true, std::memory_order_release);
+			mark_ui_dirty(ui::update_channel::selection);
 		}
 	}
 	void deselect(dcon::army_id a) {
@@ -788,7 +885,7 @@ struct alignas(64) state {
 			if(selected_armies[i] == a) {
 				selected_armies[i] = selected_armies.back();
 				selected_armies.pop_back();
-				game_state_updated.store(true, std::memory_order_release);
+				mark_ui_dirty(ui::update_channel::selection);
 				return;
 			}
 		}
@@ -798,7 +895,7 @@ struct alignas(64) state {
 			if(selected_navies[i] == a) {
 				selected_navies[i] = selected_navies.back();
 				selected_navies.pop_back();
-				game_state_updated.store(true, std::memory_order_release);
+				mark_ui_dirty(ui::update_channel::selection);
 				return;
 			}
 		}
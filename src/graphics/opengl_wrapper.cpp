@@ -419,6 +419,18 @@ void load_shaders(sys::state& state) {
 		state.open_gl.ui_shader_inner_color_uniform = glGetUniformLocation(state.open_gl.ui_shader_program, "inner_color");
 		state.open_gl.ui_shader_subrect_uniform = glGetUniformLocation(state.open_gl.ui_shader_program, "subrect");
 		state.open_gl.ui_shader_border_size_uniform = glGetUniformLocation(state.open_gl.ui_shader_program, "border_size");
+		state.open_gl.ui_shader_instanced_uniform = glGetUniformLocation(state.open_gl.ui_shader_program, "instanced");
+		if(GLint(state.open_gl.ui_shader_instanced_uniform) == -1)
+			state.open_gl.batched_text = false; // an older shader without instance support
+		state.open_gl.ui_shader_flag_atlas_sampler_uniform = glGetUniformLocation(state.open_gl.ui_shader_program, "flag_atlas_sampler");
+		if(GLint(state.open_gl.ui_shader_flag_atlas_sampler_uniform) != -1) {
+			// the array sampler must never share a unit with the 2d samplers, so it gets one of its own for good
+			glUseProgram(state.open_gl.ui_shader_program);
+			glUniform1i(state.open_gl.ui_shader_flag_atlas_sampler_uniform, 2);
+			glUseProgram(0);
+		}
+		if(GLint(state.open_gl.ui_shader_flag_atlas_sampler_uniform) == -1 || !glCopyImageSubData || !glTexStorage3D)
+			state.open_gl.flags.enabled = false; // an older shader, or no way to copy flags into the atlas
 	} else {
 		notify_user_of_fatal_opengl_error("Unable to open a necessary shader file");
 	}
@@ -499,6 +511,30 @@ void load_global_squares(sys::state& state) {
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 16, global_sub_square_data, GL_STATIC_DRAW);
 	}
+
+	// instanced glyphs: the upright square for every vertex, plus a rect and an atlas cell per instance
+	glGenBuffers(1, &state.open_gl.glyph_instance_buffer);
+	glGenVertexArrays(1, &state.open_gl.glyph_instance_vao);
+	glBindVertexArray(state.open_gl.glyph_instance_vao);
+	glEnableVertexAttribArray(0); // position
+	glEnableVertexAttribArray(1); // texture coordinates
+	glEnableVertexAttribArray(2); // instance rect
+	glEnableVertexAttribArray(3); // instance cell
+
+	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+	glBindVertexBuffer(1, state.open_gl.glyph_instance_buffer, 0, sizeof(GLfloat) * 6);
+	glVertexBindingDivisor(1, 1);
+
+	glVertexAttribFormat(0, 2, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 2);
+	glVertexAttribFormat(2, 4, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribFormat(3, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 4);
+	glVertexAttribBinding(0, 0);
+	glVertexAttribBinding(1, 0);
+	glVertexAttribBinding(2, 1);
+	glVertexAttribBinding(3, 1);
+
+	glBindVertexArray(state.open_gl.global_square_vao);
 }
 
 inline auto map_color_modification_to_index(color_modification e) {
@@ -597,6 +633,129 @@ void render_textured_rect_direct(sys::state const& state, float x, float y, floa
 	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
+flag_atlas::region find_flag_region(sys::state& state, GLuint flag_texture_handle) {
+	auto& atlas = state.open_gl.flags;
+	if(!atlas.enabled || !flag_texture_handle)
+		return flag_atlas::region{};
+	if(auto it = atlas.regions.find(flag_texture_handle); it != atlas.regions.end()) {
+		if(it->second.layer >= 0)
+			atlas.layer_last_used[it->second.layer] = atlas.current_frame;
+		return it->second;
+	}
+
+	flag_atlas::region result;
+	GLint width = 0;
+	GLint height = 0;
+	GLint format = 0;
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, flag_texture_handle);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	if(format != GL_RGBA8 || width <= 0 || height <= 0 || width > flag_atlas::cell_size || height > flag_atlas::cell_size) {
+		atlas.regions.insert_or_assign(flag_texture_handle, result); // compressed dds or oversized: never fits
+		return result;
+	}
+
+	if(!atlas.array_texture) {
+		glGenTextures(1, &atlas.array_texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, atlas.array_texture);
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, flag_atlas::cell_size, flag_atlas::cell_size, flag_atlas::layer_count);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		atlas.layer_owner.resize(flag_atlas::layer_count, 0);
+		atlas.layer_last_used.resize(flag_atlas::layer_count, 0);
+	}
+
+	int32_t victim = -1;
+	for(int32_t i = 0; i < flag_atlas::layer_count; ++i) {
+		if(!atlas.layer_owner[i]) {
+			victim = i;
+			break;
+		}
+		if(victim == -1 || atlas.layer_last_used[i] < atlas.layer_last_used[victim])
+			victim = i;
+	}
+	if(atlas.layer_owner[victim]) {
+		if(atlas.layer_last_used[victim] == atlas.current_frame)
+			return result; // every layer is on screen this frame; draw this one on its own without remembering that
+		atlas.regions.erase(atlas.layer_owner[victim]);
+	}
+
+	glCopyImageSubData(flag_texture_handle, GL_TEXTURE_2D, 0, 0, 0, 0, atlas.array_texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, victim, width, height, 1);
+	atlas.layer_owner[victim] = flag_texture_handle;
+	atlas.layer_last_used[victim] = atlas.current_frame;
+
+	result.layer = victim;
+	result.u_scale = float(width) / float(flag_atlas::cell_size);
+	result.v_scale = float(height) / float(flag_atlas::cell_size);
+	atlas.regions.insert_or_assign(flag_texture_handle, result);
+	return result;
+}
+
+void invalidate_flag_region(sys::state& state, GLuint flag_texture_handle) {
+	auto& atlas = state.open_gl.flags;
+	if(auto it = atlas.regions.find(flag_texture_handle); it != atlas.regions.end()) {
+		if(it->second.layer >= 0)
+			atlas.layer_owner[it->second.layer] = 0;
+		atlas.regions.erase(it);
+	}
+}
+
+static void bind_flag_region(sys::state const& state, flag_atlas::region const& region) {
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, state.open_gl.flags.array_texture);
+	glActiveTexture(GL_TEXTURE0);
+	glUniform4f(state.open_gl.ui_shader_subrect_uniform, region.u_scale, region.v_scale, float(region.layer), 0.5f / float(flag_atlas::cell_size));
+}
+
+void render_flag(sys::state& state, color_modification enabled, float x, float y, float width, float height, GLuint flag_texture_handle,
+		ui::rotation r, bool flipped, bool rtl) {
+	auto region = find_flag_region(state, flag_texture_handle);
+	if(region.layer < 0) {
+		render_textured_rect(state, enabled, x, y, width, height, flag_texture_handle, r, flipped, rtl);
+		return;
+	}
+	glBindVertexArray(state.open_gl.global_square_vao);
+
+	bind_vertices_by_rotation(state, r, flipped, rtl);
+
+	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
+	bind_flag_region(state, region);
+
+	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::atlas_flag};
+	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, subroutines[0], subroutines[1]);
+
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+}
+
+void render_masked_flag(sys::state& state, color_modification enabled, float x, float y, float width, float height, GLuint flag_texture_handle,
+		GLuint mask_texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	auto region = find_flag_region(state, flag_texture_handle);
+	if(region.layer < 0) {
+		render_masked_rect(state, enabled, x, y, width, height, flag_texture_handle, mask_texture_handle, r, flipped, rtl);
+		return;
+	}
+	glBindVertexArray(state.open_gl.global_square_vao);
+
+	bind_vertices_by_rotation(state, r, flipped, rtl);
+
+	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, mask_texture_handle);
+	bind_flag_region(state, region);
+
+	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::atlas_flag_mask};
+	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, subroutines[0], subroutines[1]);
+
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+}
+
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		lines& l) {
 	glBindVertexArray(state.open_gl.global_square_vao);
@@ -912,15 +1071,20 @@ void render_text_flag(sys::state& state, text::embedded_flag ico, float x, float
 		flag_type = culture::get_current_flag_type(state, ico.tag);
 	}
 	GLuint flag_texture_handle = ogl::get_flag_handle(state, ico.tag, flag_type);
+	auto region = find_flag_region(state, flag_texture_handle);
 
-	GLuint icon_subroutines[2] = { map_color_modification_to_index(cmod), parameters::no_filter };
+	GLuint icon_subroutines[2] = { map_color_modification_to_index(cmod), region.layer < 0 ? parameters::no_filter : parameters::atlas_flag };
 	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, icon_subroutines[0], icon_subroutines[1]);
 	//glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, icon_subroutines); // must set all subroutines in one call
 	bind_vertices_by_rotation(state, ui::rotation::upright, false, false);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, flag_texture_handle);
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, icon_baseline + font_size * 0.15f, 1.5f * font_size * 0.9f,  font_size * 0.9f);
-	glUniform4f(state.open_gl.ui_shader_subrect_uniform, 0.f, 1.f, 0.f, 1.f);
+	if(region.layer < 0) {
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, flag_texture_handle);
+		glUniform4f(state.open_gl.ui_shader_subrect_uniform, 0.f, 1.f, 0.f, 1.f);
+	} else {
+		bind_flag_region(state, region);
+	}
 	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
@@ -1004,11 +1168,75 @@ void render_text_commodity_icon(
 	);
 }
 
+void flush_glyph_instances(sys::state& state, GLuint texture_handle) {
+	auto& instances = state.open_gl.glyph_instances;
+	if(instances.empty())
+		return;
+
+	auto const bytes = GLsizeiptr(sizeof(GLfloat) * instances.size());
+	glBindBuffer(GL_ARRAY_BUFFER, state.open_gl.glyph_instance_buffer);
+	if(bytes > state.open_gl.glyph_instance_buffer_size)
+		state.open_gl.glyph_instance_buffer_size = std::max(bytes, GLsizeiptr(sizeof(GLfloat) * 6 * 256));
+	// orphan the previous contents so that the driver does not have to wait on draws still reading them
+	glBufferData(GL_ARRAY_BUFFER, state.open_gl.glyph_instance_buffer_size, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture_handle);
+	glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, GLsizei(instances.size() / 6));
+	instances.clear();
+}
+
+void internal_text_render_batched(sys::state& state, text::stored_glyphs const& txt, float x, float baseline_y, float size, text::font& f) {
+	// consecutive glyphs on the same font texture page share a single instanced draw; since every glyph of the string is
+	// drawn before anything else this preserves the order they would be drawn in one by one
+	glBindVertexArray(state.open_gl.glyph_instance_vao);
+	glUniform1ui(state.open_gl.ui_shader_instanced_uniform, 1);
+
+	auto& instances = state.open_gl.glyph_instances;
+	instances.clear();
+	GLuint current_texture = 0;
+
+	unsigned int glyph_count = static_cast<unsigned int>(txt.glyph_info.size());
+	for(unsigned int i = 0; i < glyph_count; i++) {
+		hb_codepoint_t glyphid = txt.glyph_info[i].codepoint;
+		auto gso = f.glyph_positions[glyphid];
+		float x_advance = float(txt.glyph_info[i].x_advance) / (float((1 << 6) * text::magnification_factor));
+		float x_offset = float(txt.glyph_info[i].x_offset) / (float((1 << 6) * text::magnification_factor)) + float(gso.x);
+		float y_offset = float(gso.y) - float(txt.glyph_info[i].y_offset) / (float((1 << 6) * text::magnification_factor));
+		assert(uint32_t(gso.texture_slot >> 6) < f.textures.size());
+		assert(f.textures[gso.texture_slot >> 6]);
+		auto texture = f.textures[gso.texture_slot >> 6];
+		if(texture != current_texture) {
+			flush_glyph_instances(state, current_texture);
+			current_texture = texture;
+		}
+		auto const cell = gso.texture_slot & 63;
+		instances.push_back(x + x_offset * size / 64.f);
+		instances.push_back(baseline_y + y_offset * size / 64.f);
+		instances.push_back(size);
+		instances.push_back(size);
+		instances.push_back(float(cell & 7) / 8.0f);
+		instances.push_back(float((cell >> 3) & 7) / 8.0f);
+		x += x_advance * size / 64.f;
+		baseline_y -= (float(txt.glyph_info[i].y_advance) / (float((1 << 6) * text::magnification_factor))) * size / 64.f;
+	}
+	flush_glyph_instances(state, current_texture);
+
+	glUniform1ui(state.open_gl.ui_shader_instanced_uniform, 0);
+	glBindVertexArray(state.open_gl.global_square_vao);
+}
+
 void internal_text_render(sys::state& state, text::stored_glyphs const& txt, float x, float baseline_y, float size, text::font& f) {
 	GLuint subroutines[2] = { map_color_modification_to_index(ogl::color_modification::none), parameters::filter };
 	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, subroutines[0], subroutines[1]);
 	//glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
 
+	if(state.open_gl.batched_text && state.open_gl.glyph_instance_vao != 0) {
+		internal_text_render_batched(state, txt, x, baseline_y, size, f);
+		return;
+	}
+
 	unsigned int glyph_count = static_cast<unsigned int>(txt.glyph_info.size());
 	for(unsigned int i = 0; i < glyph_count; i++) {
 		hb_codepoint_t glyphid = txt.glyph_info[i].codepoint;
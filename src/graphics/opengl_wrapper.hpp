@@ -2,6 +2,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #ifndef GLEW_STATIC
 #define GLEW_STATIC
@@ -43,6 +44,8 @@ inline constexpr GLuint alternate_tint = 16;
 inline constexpr GLuint linegraph_color = 17;
 inline constexpr GLuint transparent_color = 18;
 inline constexpr GLuint solid_color = 19;
+inline constexpr GLuint atlas_flag = 20;
+inline constexpr GLuint atlas_flag_mask = 21;
 } // namespace parameters
 
 enum class color_modification { none, disabled, interactable, interactable_disabled };
@@ -193,9 +196,31 @@ inline void debug_callback(GLenum source, GLenum type, GLuint id, GLenum severit
 }
 #endif
 
+// Flags drawn by the ui are copied into the layers of a single array texture, so that a screen full of flags does not bind a
+// texture per flag. Layers are handed out on first draw and recycled least recently drawn first.
+struct flag_atlas {
+	static constexpr int32_t cell_size = 128; // flags larger than this are drawn from their own texture
+	static constexpr int32_t layer_count = 256;
+
+	struct region {
+		int32_t layer = -1; // -1: this texture cannot be placed in the atlas
+		float u_scale = 1.0f;
+		float v_scale = 1.0f;
+	};
+
+	GLuint array_texture = 0;
+	bool enabled = true;
+	uint32_t current_frame = 0;
+	std::vector<GLuint> layer_owner; // texture handle copied into each layer, 0 if free
+	std::vector<uint32_t> layer_last_used; // frame each layer was last drawn in
+	ankerl::unordered_dense::map<GLuint, region> regions; // by flag texture handle
+};
+
 struct data {
 	tagged_vector<texture, dcon::texture_id> asset_textures;
 	ankerl::unordered_dense::map<std::string, dcon::texture_id> late_loaded_map;
+	texture_streamer texture_streaming;
+	flag_atlas flags;
 
 	void* context = nullptr;
 	bool legacy_mode = false;
@@ -211,6 +236,8 @@ struct data {
 	GLuint ui_shader_screen_width_uniform = 0;
 	GLuint ui_shader_screen_height_uniform = 0;
 	GLuint ui_shader_gamma_uniform = 0;
+	GLuint ui_shader_instanced_uniform = 0;
+	GLuint ui_shader_flag_atlas_sampler_uniform = 0;
 
 	GLuint global_square_vao = 0;
 	GLuint global_square_buffer = 0;
@@ -229,6 +256,13 @@ struct data {
 
 	GLuint sub_square_buffers[64] = {0};
 
+	// glyphs of a single string are drawn instanced: one draw per run of glyphs sharing a font texture page
+	GLuint glyph_instance_vao = 0;
+	GLuint glyph_instance_buffer = 0;
+	GLsizeiptr glyph_instance_buffer_size = 0;
+	std::vector<GLfloat> glyph_instances; // x, y, width, height, cell x, cell y
+	bool batched_text = true; // false falls back to one draw per glyph
+
 	GLuint money_icon_tex = 0;
 	GLuint cross_icon_tex = 0;
 	GLuint color_blind_cross_icon_tex = 0;
@@ -299,6 +333,13 @@ void render_colored_rect(sys::state const& state, float x, float y, float width,
 void render_simple_rect(sys::state const& state, float x, float y, float width, float height, ui::rotation r, bool flipped, bool rtl);
 void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		GLuint texture_handle, ui::rotation r, bool flipped, bool rtl);
+// flags go through the flag atlas when they fit in it and through render_textured_rect / render_masked_rect otherwise
+void render_flag(sys::state& state, color_modification enabled, float x, float y, float width, float height, GLuint flag_texture_handle,
+		ui::rotation r, bool flipped, bool rtl);
+void render_masked_flag(sys::state& state, color_modification enabled, float x, float y, float width, float height, GLuint flag_texture_handle,
+		GLuint mask_texture_handle, ui::rotation r, bool flipped, bool rtl);
+flag_atlas::region find_flag_region(sys::state& state, GLuint flag_texture_handle);
+void invalidate_flag_region(sys::state& state, GLuint flag_texture_handle); // call when the contents of a flag texture change
 void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle);
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height, lines& l);
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height, float r, float g, float b, lines& l);
@@ -777,6 +777,7 @@ texture::~texture() {
 texture::texture(texture&& other) noexcept {
 	channels = other.channels;
 	loaded = other.loaded;
+	pending = other.pending;
 	size_x = other.size_x;
 	size_y = other.size_y;
 	data = other.data;
@@ -787,6 +788,7 @@ texture::texture(texture&& other) noexcept {
 texture& texture::operator=(texture&& other) noexcept {
 	channels = other.channels;
 	loaded = other.loaded;
+	pending = other.pending;
 	size_x = other.size_x;
 	size_y = other.size_y;
 	data = other.data;
@@ -801,19 +803,23 @@ GLuint texture::get_texture_handle() const {
 	return texture_handle;
 }
 
+// replaces a three letter extension, for the dds and png fallbacks
+static native_string with_extension(native_string name, native_char const* ext) {
+	if(auto pos = name.find_last_of('.'); pos != native_string::npos) {
+		name[pos + 1] = ext[0];
+		name[pos + 2] = ext[1];
+		name[pos + 3] = ext[2];
+		name.resize(pos + 4);
+	}
+	return name;
+}
+
 GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs, texture& asset_texture, bool keep_data) {
 	auto name_length = native_name.length();
 
 	auto root = get_root(fs);
 	if(name_length > 4) { // try loading as a dds
-		auto dds_name = native_name;
-		if(auto pos = dds_name.find_last_of('.'); pos != native_string::npos) {
-			dds_name[pos + 1] = NATIVE('d');
-			dds_name[pos + 2] = NATIVE('d');
-			dds_name[pos + 3] = NATIVE('s');
-			dds_name.resize(pos + 4);
-		}
-		auto file = open_file(root, dds_name);
+		auto file = open_file(root, with_extension(native_name, NATIVE("dds")));
 		if(file) {
 			auto content = simple_fs::view_contents(*file);
 
@@ -839,14 +845,7 @@ GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::
 
 	auto file = open_file(root, native_name);
 	if(!file && name_length > 4) {
-		auto png_name = native_name;
-		if(auto pos = png_name.find_last_of('.'); pos != native_string::npos) {
-			png_name[pos + 1] = NATIVE('p');
-			png_name[pos + 2] = NATIVE('n');
-			png_name[pos + 3] = NATIVE('g');
-			png_name.resize(pos + 4);
-		}
-		file = open_file(root, png_name);
+		file = open_file(root, with_extension(native_name, NATIVE("png")));
 	}
 	if(file) {
 		auto content = simple_fs::view_contents(*file);
@@ -993,6 +992,24 @@ GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, cul
 		file_str += simple_fs::win1250_to_native(nations::int_to_tag(state.world.national_identity_get_identifying_int(masq_nat_id)));
 		native_string default_file_str = file_str;
 		file_str += flag_type_to_name(state, type);
+		if(state.open_gl.asset_textures[id].pending) {
+			return state.open_gl.asset_textures[id].texture_handle;
+		}
+		if(state.open_gl.texture_streaming.enabled) {
+			native_string const candidates[] = { file_str + NATIVE(".png"), file_str + NATIVE(".tga"), default_file_str + NATIVE(".png"), default_file_str + NATIVE(".tga") };
+			for(auto& c : candidates) {
+				switch(stream_texture_file(state, c, id)) {
+				case stream_status::queued:
+					return state.open_gl.asset_textures[id].texture_handle;
+				case stream_status::load_directly:
+					return load_file_and_return_handle(c, state.common_fs, state.open_gl.asset_textures[id], false);
+				case stream_status::not_found:
+					break;
+				}
+			}
+			state.open_gl.asset_textures[id].loaded = true;
+			return 0;
+		}
 		GLuint p_tex = load_file_and_return_handle(file_str + NATIVE(".png"), state.common_fs, state.open_gl.asset_textures[id], false);
 		if(!p_tex) {
 			p_tex = load_file_and_return_handle(file_str + NATIVE(".tga"), state.common_fs, state.open_gl.asset_textures[id], false);
@@ -1020,22 +1037,213 @@ GLuint get_late_load_texture_handle(sys::state& state, dcon::texture_id& id, std
 		id = new_id;
 		state.open_gl.late_loaded_map.insert_or_assign(std::string(asset_name), new_id);
 		native_string nname = native_string(NATIVE("assets")) + NATIVE_DIR_SEPARATOR + simple_fs::utf8_to_native(asset_name);
-		return load_file_and_return_handle(nname, state.common_fs, state.open_gl.asset_textures.back(), false);
+		if(state.open_gl.texture_streaming.enabled && stream_texture_file(state, nname, new_id) == stream_status::queued) {
+			return state.open_gl.asset_textures[new_id].texture_handle;
+		}
+		return load_file_and_return_handle(nname, state.common_fs, state.open_gl.asset_textures[new_id], false);
 	}
 }
 
 GLuint get_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data) {
-	if(state.open_gl.asset_textures[id].loaded) {
-		return state.open_gl.asset_textures[id].texture_handle;
-	} else { // load from file
+	auto& asset_texture = state.open_gl.asset_textures[id];
+	if(asset_texture.loaded || (asset_texture.pending && !keep_data)) {
+		return asset_texture.texture_handle;
+	} else if(keep_data || !state.open_gl.texture_streaming.enabled) { // the caller wants the pixels now
+		return get_loaded_texture_handle(state, id, keep_data);
+	} else { // load from file, in the background
 		auto fname = state.ui_defs.textures[id];
-		auto fname_view = state.to_string_view(fname);
-		auto native_name = simple_fs::win1250_to_native(fname_view);
-
-		return load_file_and_return_handle(native_name, state.common_fs, state.open_gl.asset_textures[id], keep_data);
+		auto native_name = simple_fs::win1250_to_native(state.to_string_view(fname));
+		if(stream_texture_file(state, native_name, id) == stream_status::queued) {
+			return asset_texture.texture_handle;
+		}
+		return load_file_and_return_handle(native_name, state.common_fs, asset_texture, keep_data);
 	} // end else (not already loaded)
 }
 
+GLuint get_loaded_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data) {
+	auto& asset_texture = state.open_gl.asset_textures[id];
+	if(asset_texture.loaded) {
+		return asset_texture.texture_handle;
+	}
+	auto fname = state.ui_defs.textures[id];
+	auto native_name = simple_fs::win1250_to_native(state.to_string_view(fname));
+	if(!asset_texture.pending) {
+		return load_file_and_return_handle(native_name, state.common_fs, asset_texture, keep_data);
+	}
+
+	// already queued: decode it here instead, into the placeholder that callers may have kept, and drop the streamed copy when it arrives
+	auto root = get_root(state.common_fs);
+	auto file = open_file(root, native_name);
+	if(!file) {
+		file = open_file(root, with_extension(native_name, NATIVE("png")));
+	}
+	asset_texture.loaded = true;
+	if(file) {
+		auto image = decode_texture(simple_fs::view_contents(*file));
+		if(image.data) {
+			asset_texture.size_x = image.size_x;
+			asset_texture.size_y = image.size_y;
+			asset_texture.channels = 4;
+			glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.size_x, image.size_y, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			if(keep_data) {
+				asset_texture.data = image.data;
+				image.data = nullptr;
+			}
+		}
+		free_decoded_texture(image);
+	}
+	return asset_texture.texture_handle;
+}
+
+decoded_texture decode_texture(simple_fs::file_contents content) {
+	decoded_texture result;
+	int32_t file_channels = 4;
+	result.data = stbi_load_from_memory(reinterpret_cast<uint8_t const*>(content.data), int32_t(content.file_size), &result.size_x, &result.size_y, &file_channels, 4);
+	if(!result.data) {
+		result.size_x = 0;
+		result.size_y = 0;
+	}
+	return result;
+}
+
+void free_decoded_texture(decoded_texture& t) {
+	STBI_FREE(t.data);
+	t.data = nullptr;
+}
+
+texture_streamer::~texture_streamer() {
+	{
+		std::lock_guard guard{ lock };
+		stopping = true;
+	}
+	work_available.notify_all();
+	for(auto& w : workers)
+		w.join();
+	for(auto& r : finished)
+		free_decoded_texture(r.image);
+}
+
+void texture_streamer::worker_loop() {
+	while(true) {
+		std::unique_lock guard{ lock };
+		work_available.wait(guard, [&]() { return stopping || !jobs.empty(); });
+		if(stopping)
+			return;
+		auto j = std::move(jobs.front());
+		jobs.pop_front();
+		guard.unlock();
+
+		auto image = decode_texture(simple_fs::view_contents(j.file));
+
+		guard.lock();
+		finished.push_back(result{ j.id, image });
+	}
+}
+
+void texture_streamer::queue(dcon::texture_id id, simple_fs::file&& f) {
+	{
+		std::lock_guard guard{ lock };
+		jobs.push_back(job{ id, std::move(f) });
+		if(workers.empty()) {
+			auto count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+			for(uint32_t i = 0; i < count; ++i)
+				workers.emplace_back([this]() { worker_loop(); });
+		}
+	}
+	work_available.notify_one();
+}
+
+std::optional<texture_streamer::result> texture_streamer::pop_finished() {
+	std::lock_guard guard{ lock };
+	if(finished.empty())
+		return std::nullopt;
+	auto r = finished.front();
+	finished.pop_front();
+	return r;
+}
+
+stream_status stream_texture_file(sys::state& state, native_string const& native_name, dcon::texture_id id) {
+	auto root = get_root(state.common_fs);
+	if(native_name.length() > 4 && open_file(root, with_extension(native_name, NATIVE("dds")))) {
+		return stream_status::load_directly; // already in a gpu format
+	}
+	auto file = open_file(root, native_name);
+	if(!file && native_name.length() > 4) {
+		file = open_file(root, with_extension(native_name, NATIVE("png")));
+	}
+	if(!file) {
+		return stream_status::not_found;
+	}
+
+	auto& asset_texture = state.open_gl.asset_textures[id];
+	if(!asset_texture.texture_handle) {
+		// the final handle is handed out right away, so callers that keep it see the image once it is uploaded
+		uint8_t const transparent[4] = { 0, 0, 0, 0 };
+		glGenTextures(1, &asset_texture.texture_handle);
+		glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparent);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	asset_texture.pending = true;
+	state.open_gl.texture_streaming.queue(id, std::move(*file));
+	return stream_status::queued;
+}
+
+void process_texture_uploads(sys::state& state) {
+	auto& streamer = state.open_gl.texture_streaming;
+	uint32_t uploaded = 0;
+	while(uploaded < streamer.upload_budget) {
+		auto r = streamer.pop_finished();
+		if(!r)
+			break;
+
+		auto& asset_texture = state.open_gl.asset_textures[r->id];
+		asset_texture.pending = false;
+		if(asset_texture.loaded || !r->image.data) { // loaded synchronously in the meantime, or undecodable
+			asset_texture.loaded = true;
+			free_decoded_texture(r->image);
+			continue;
+		}
+		asset_texture.size_x = r->image.size_x;
+		asset_texture.size_y = r->image.size_y;
+		asset_texture.channels = 4;
+		asset_texture.loaded = true;
+
+		auto bytes = GLsizeiptr(r->image.size_x) * GLsizeiptr(r->image.size_y) * 4;
+		if(!streamer.pixel_buffer) {
+			glGenBuffers(1, &streamer.pixel_buffer);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, streamer.pixel_buffer);
+		if(streamer.pixel_buffer_size < bytes) {
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+			streamer.pixel_buffer_size = bytes;
+		}
+		// invalidating lets the driver hand out fresh storage instead of waiting on the previous upload
+		void* dest = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+		if(dest) {
+			std::memcpy(dest, r->image.data, size_t(bytes));
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, r->image.size_x, r->image.size_y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		} else {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, r->image.size_x, r->image.size_y, 0, GL_RGBA, GL_UNSIGNED_BYTE, r->image.data);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		invalidate_flag_region(state, asset_texture.texture_handle); // a flag may have been atlased as its placeholder
+
+		free_decoded_texture(r->image);
+		uploaded += uint32_t(bytes);
+	}
+}
+
 data_texture::data_texture(int32_t sz, int32_t ch) {
 	size = sz;
 	channels = ch;
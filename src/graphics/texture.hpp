@@ -1,6 +1,13 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 #include "container_types.hpp"
+#include "simple_fs.hpp"
 
 #ifndef GLEW_STATIC
 #define GLEW_STATIC
@@ -12,6 +19,7 @@ namespace ogl {
 class texture;
 
 GLuint get_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data);
+GLuint get_loaded_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data); // never defers to the streamer
 native_string flag_type_to_name(sys::state& state, culture::flag_type type);
 GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, culture::flag_type type);
 GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs, texture& asset_texture, bool keep_data);
@@ -23,6 +31,60 @@ enum {
 
 GLuint SOIL_direct_load_DDS_from_memory(unsigned char const* const buffer, uint32_t buffer_length, uint32_t& width, uint32_t& height, int soil_flags);
 
+// the cpu side of loading a png / tga: produces rgba8 pixels without touching opengl, so it may run on any thread
+struct decoded_texture {
+	uint8_t* data = nullptr; // allocated with STBI_MALLOC; null if the file could not be decoded
+	int32_t size_x = 0;
+	int32_t size_y = 0;
+};
+decoded_texture decode_texture(simple_fs::file_contents content);
+void free_decoded_texture(decoded_texture& t);
+
+// Decodes textures on worker threads so that first use of a texture does not stall the frame.
+// Files are located and opened on the render thread (the file_system is not thread safe); workers only see the mapped contents.
+// Finished images are uploaded by process_texture_uploads, a few per frame.
+class texture_streamer {
+public:
+	struct result {
+		dcon::texture_id id;
+		decoded_texture image;
+	};
+
+private:
+	struct job {
+		dcon::texture_id id;
+		simple_fs::file file;
+	};
+
+	std::mutex lock;
+	std::condition_variable work_available;
+	std::deque<job> jobs;
+	std::deque<result> finished;
+	std::vector<std::thread> workers;
+	bool stopping = false;
+
+	void worker_loop();
+
+public:
+	bool enabled = true; // false loads every texture synchronously on first use
+	uint32_t upload_budget = 4 * 1024 * 1024; // bytes of pixel data uploaded per frame (at least one texture is always uploaded)
+	GLuint pixel_buffer = 0;
+	GLsizeiptr pixel_buffer_size = 0;
+
+	texture_streamer() = default;
+	texture_streamer(texture_streamer const&) = delete;
+	texture_streamer& operator=(texture_streamer const&) = delete;
+	~texture_streamer();
+
+	void queue(dcon::texture_id id, simple_fs::file&& f);
+	std::optional<result> pop_finished();
+};
+
+enum class stream_status { queued, load_directly, not_found };
+// finds the file load_file_and_return_handle would decode and queues it; dds files are left to the synchronous path
+stream_status stream_texture_file(sys::state& state, native_string const& native_name, dcon::texture_id id);
+void process_texture_uploads(sys::state& state); // render thread only
+
 class texture {
 	GLuint texture_handle = 0;
 
@@ -33,6 +95,7 @@ public:
 	int32_t channels = 4;
 
 	bool loaded = false;
+	bool pending = false; // queued with the texture_streamer; texture_handle is a transparent placeholder until it arrives
 
 	texture() { }
 	texture(texture const&) = delete;
@@ -45,6 +108,9 @@ public:
 	GLuint get_texture_handle() const;
 
 	friend GLuint get_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data);
+	friend GLuint get_loaded_texture_handle(sys::state& state, dcon::texture_id id, bool keep_data);
+	friend stream_status stream_texture_file(sys::state& state, native_string const& native_name, dcon::texture_id id);
+	friend void process_texture_uploads(sys::state& state);
 	friend GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs,
 			texture& asset_texture, bool keep_data);
 	friend GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, culture::flag_type type);
@@ -520,15 +520,14 @@ public:
 class nation_prestige_text : public standard_nation_text {
 public:
 	std::string get_text(sys::state& state, dcon::nation_id nation_id) noexcept override {
-		return std::to_string(int32_t(nations::prestige_score(state, nation_id)));
+		return std::to_string(int32_t(state.ui_snapshots.front().nation(nation_id).prestige));
 	}
 };
 
 class nation_industry_score_text : public standard_nation_text {
 public:
 	std::string get_text(sys::state& state, dcon::nation_id nation_id) noexcept override {
-		auto fat_id = dcon::fatten(state.world, nation_id);
-		return std::to_string(int32_t(fat_id.get_industrial_score()));
+		return std::to_string(int32_t(state.ui_snapshots.front().nation(nation_id).industrial_score));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -603,8 +602,7 @@ public:
 class nation_military_score_text : public standard_nation_text {
 public:
 	std::string get_text(sys::state& state, dcon::nation_id nation_id) noexcept override {
-		auto fat_id = dcon::fatten(state.world, nation_id);
-		return std::to_string(int32_t(fat_id.get_military_score()));
+		return std::to_string(int32_t(state.ui_snapshots.front().nation(nation_id).military_score));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -635,9 +633,8 @@ public:
 class nation_total_score_text : public standard_nation_text {
 public:
 	std::string get_text(sys::state& state, dcon::nation_id nation_id) noexcept override {
-		auto fat_id = dcon::fatten(state.world, nation_id);
-		return std::to_string(
-				int32_t(nations::prestige_score(state, nation_id) + fat_id.get_industrial_score() + fat_id.get_military_score()));
+		auto const& v = state.ui_snapshots.front().nation(nation_id);
+		return std::to_string(int32_t(v.prestige + v.industrial_score + v.military_score));
 	}
 };
 
@@ -690,8 +687,7 @@ public:
 class nation_rank_text : public standard_nation_text {
 public:
 	std::string get_text(sys::state& state, dcon::nation_id nation_id) noexcept override {
-		auto fat_id = dcon::fatten(state.world, nation_id);
-		return std::to_string(fat_id.get_rank());
+		return std::to_string(state.ui_snapshots.front().nation(nation_id).rank);
 	}
 };
 
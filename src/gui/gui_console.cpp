@@ -639,6 +639,119 @@ int32_t* f_daily_oos(fif::state_stack& s, int32_t* p, fif::environment* e) {
 	state->cheat_data.daily_oos_check = toggle_state;
 	return p + 2;
 }
+int32_t* f_trigger_clause_stats(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	if(toggle_state) {
+		trigger::load_clause_statistics(*state);
+	} else if(state->trigger_clause_statistics.collecting.load(std::memory_order_acquire)) {
+		trigger::save_clause_statistics(*state); // picked up on the next load when alice_reorder_trigger_clauses is set
+	}
+	state->trigger_clause_statistics.collecting.store(toggle_state, std::memory_order_release);
+	return p + 2;
+}
+int32_t* f_trigger_memo_stats(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	log_to_console(*state, state->ui_state.console_window, trigger::memo_summary(*state));
+	return p + 2;
+}
+int32_t* f_batched_text(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	// false draws text one glyph at a time, for comparing against the instanced path
+	state->open_gl.batched_text = toggle_state && GLint(state->open_gl.ui_shader_instanced_uniform) != -1;
+	return p + 2;
+}
+int32_t* f_texture_streaming(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	// false loads textures synchronously on first use; textures already queued still arrive through the streamer
+	state->open_gl.texture_streaming.enabled = toggle_state;
+	return p + 2;
+}
+int32_t* f_flag_atlas(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	// false draws every flag from its own texture again
+	state->open_gl.flags.enabled = toggle_state && GLint(state->open_gl.ui_shader_flag_atlas_sampler_uniform) != -1 && glCopyImageSubData && glTexStorage3D;
+	return p + 2;
+}
+int32_t* f_script_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	if(toggle_state) {
+		trigger::start_script_profile(*state);
+		log_to_console(*state, state->ui_state.console_window, "Script profiling started");
+	} else {
+		trigger::stop_script_profile(*state);
+		log_to_console(*state, state->ui_state.console_window, trigger::script_profile_summary(*state, 10));
+		log_to_console(*state, state->ui_state.console_window, "Check \"My Documents\\Project Alice\\data_dumps\" for script_profile.csv");
+	}
+	return p + 2;
+}
 int32_t* f_cheat_decision_potential(fif::state_stack& s, int32_t* p, fif::environment* e) {
 	if(fif::typechecking_mode(e->mode)) {
 		if(fif::typechecking_failed(e->mode))
@@ -1380,6 +1493,12 @@ void ui::initialize_console_fif_environment(sys::state& state) {
 	fif::add_import("cheat-navy", nullptr, f_cheat_navy, { fif::fif_bool }, {}, * state.fif_environment);
 	fif::add_import("cheat-factories", nullptr, f_cheat_factories, { fif::fif_bool }, {}, * state.fif_environment);
 	fif::add_import("daily-oos-check", nullptr, f_daily_oos, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("trigger-clause-stats", nullptr, f_trigger_clause_stats, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("script-profile", nullptr, f_script_profile, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("trigger-memo-stats", nullptr, f_trigger_memo_stats, { }, {}, * state.fif_environment);
+	fif::add_import("batched-text", nullptr, f_batched_text, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("texture-streaming", nullptr, f_texture_streaming, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("flag-atlas", nullptr, f_flag_atlas, { fif::fif_bool }, {}, * state.fif_environment);
 	fif::add_import("set-auto-choice", nullptr, f_set_auto_choice, { fif::fif_bool }, {}, *state.fif_environment);
 	fif::add_import("complete-construction", nullptr, f_complete_construction, { nation_id_type }, {}, * state.fif_environment);
 	fif::add_import("instant-research", nullptr, f_instant_research, { nation_id_type, fif::fif_bool }, {}, * state.fif_environment);
@@ -60,6 +60,10 @@ public:
 		on_drag_finish(state);
 	}
 
+	virtual uint32_t update_channels(sys::state& state) noexcept { // the update_channel bits this element (and its children) read from
+		return update_channel::all;
+	}
+
 	virtual tooltip_behavior has_tooltip(sys::state& state) noexcept { // used to test whether a tooltip is possible
 		return tooltip_behavior::no_tooltip;
 	}
@@ -60,7 +60,8 @@ void container_base::impl_on_update(sys::state& state) noexcept {
 	on_update(state);
 	if(is_visible()) {
 		for(auto& c : children) {
-			if(c->is_visible() || (c->flags & element_base::wants_update_when_hidden_mask) != 0) {
+			if((c->is_visible() || (c->flags & element_base::wants_update_when_hidden_mask) != 0)
+					&& (c->update_channels(state) & state.ui_state.update_channels) != 0) {
 				c->impl_on_update(state);
 			}
 		}
@@ -1188,7 +1189,7 @@ void make_size_from_graphics(sys::state& state, ui::element_data& dat) {
 			} else {
 				auto tex_handle = gfx_def.primary_texture_handle;
 				if(tex_handle) {
-					ogl::get_texture_handle(state, tex_handle, gfx_def.is_partially_transparent());
+					ogl::get_loaded_texture_handle(state, tex_handle, gfx_def.is_partially_transparent());
 					dat.size.y = int16_t(state.open_gl.asset_textures[tex_handle].size_y);
 					dat.size.x = int16_t(state.open_gl.asset_textures[tex_handle].size_x / gfx_def.number_of_frames);
 				}
@@ -1231,8 +1232,49 @@ state::state() {
 
 state::~state() = default;
 
+void collect_window_textures(sys::state& state, ui::element_data const& window, std::vector<dcon::texture_id>& out) {
+	auto first_child = window.data.window.first_child;
+	for(uint32_t i = 0; i < window.data.window.num_children; ++i) {
+		auto const& child = state.ui_defs.gui[dcon::gui_def_id(dcon::gui_def_id::value_base_t(i + first_child.index()))];
+		dcon::gfx_object_id gfx_handle;
+		if(child.get_element_type() == ui::element_type::image) {
+			gfx_handle = child.data.image.gfx_object;
+		} else if(child.get_element_type() == ui::element_type::button) {
+			gfx_handle = child.data.button.button_image;
+		} else if(child.get_element_type() == ui::element_type::window) {
+			collect_window_textures(state, child, out);
+		}
+		if(gfx_handle) {
+			auto const& gfx_def = state.ui_defs.gfx[gfx_handle];
+			// sizeless graphics and those kept for hit testing are loaded synchronously anyway
+			if(gfx_def.primary_texture_handle && gfx_def.size.x != 0 && !gfx_def.is_partially_transparent()) {
+				out.push_back(gfx_def.primary_texture_handle);
+			}
+		}
+	}
+}
+
+void preload_window_textures(sys::state& state, ui::element_data const& window) {
+	auto first_child = window.data.window.first_child;
+	if(!first_child || !state.open_gl.texture_streaming.enabled)
+		return;
+	auto& preloaded = state.ui_state.preloaded_windows;
+	if(preloaded.size() <= size_t(first_child.index()))
+		preloaded.resize(state.ui_defs.gui.size());
+	if(preloaded[first_child.index()])
+		return;
+	preloaded[first_child.index()] = true;
+
+	std::vector<dcon::texture_id> manifest;
+	collect_window_textures(state, window, manifest);
+	for(auto id : manifest) {
+		ogl::get_texture_handle(state, id, false);
+	}
+}
+
 void window_element_base::on_create(sys::state& state) noexcept {
 	if(base_data.get_element_type() == element_type::window) {
+		preload_window_textures(state, base_data);
 		auto first_child = base_data.data.window.first_child;
 		auto num_children = base_data.data.window.num_children;
 		for(auto ex : state.ui_defs.extensions) {
@@ -2055,7 +2097,7 @@ void flag_button2::render(sys::state& state, int32_t x, int32_t y) noexcept {
 		if(gfx_def.type_dependent) {
 			auto mask_handle = ogl::get_texture_handle(state, dcon::texture_id(gfx_def.type_dependent - 1), true);
 			auto& mask_tex = state.open_gl.asset_textures[dcon::texture_id(gfx_def.type_dependent - 1)];
-			ogl::render_masked_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+			ogl::render_masked_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 				float(x) + float(base_data.size.x - mask_tex.size_x) * 0.5f,
 				float(y) + float(base_data.size.y - mask_tex.size_y) * 0.5f,
 				float(mask_tex.size_x),
@@ -2063,7 +2105,7 @@ void flag_button2::render(sys::state& state, int32_t x, int32_t y) noexcept {
 				flag_texture_handle, mask_handle, base_data.get_rotation(), gfx_def.is_vertically_flipped(),
 				false);
 		} else {
-			ogl::render_textured_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+			ogl::render_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 				float(x), float(y), float(base_data.size.x), float(base_data.size.y), flag_texture_handle, base_data.get_rotation(),
 				gfx_def.is_vertically_flipped(),
 				false);
@@ -2107,7 +2149,7 @@ void flag_button::render(sys::state& state, int32_t x, int32_t y) noexcept {
 		if(gfx_def.type_dependent) {
 			auto mask_handle = ogl::get_texture_handle(state, dcon::texture_id(gfx_def.type_dependent - 1), true);
 			auto& mask_tex = state.open_gl.asset_textures[dcon::texture_id(gfx_def.type_dependent - 1)];
-			ogl::render_masked_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+			ogl::render_masked_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 				float(x) + float(base_data.size.x - mask_tex.size_x) * 0.5f,
 				float(y) + float(base_data.size.y - mask_tex.size_y) * 0.5f,
 				float(mask_tex.size_x),
@@ -2115,7 +2157,7 @@ void flag_button::render(sys::state& state, int32_t x, int32_t y) noexcept {
 				flag_texture_handle, mask_handle, base_data.get_rotation(), gfx_def.is_vertically_flipped(),
 				false);
 		} else {
-			ogl::render_textured_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+			ogl::render_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 				float(x), float(y), float(base_data.size.x), float(base_data.size.y), flag_texture_handle, base_data.get_rotation(),
 				gfx_def.is_vertically_flipped(),
 				false);
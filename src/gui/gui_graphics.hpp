@@ -349,6 +349,24 @@ enum class message_result { unseen, seen, consumed };
 enum class focus_result { ignored, accepted };
 enum class tooltip_behavior { tooltip, variable_tooltip, position_sensitive_tooltip, no_tooltip };
 
+// the kinds of data an element reads in on_update; the ui only revisits the elements subscribed to a channel that has been touched
+// since the last update (see element_base::update_channels and sys::state::mark_ui_dirty)
+namespace update_channel {
+inline constexpr uint32_t date = 0x0001;
+inline constexpr uint32_t budget = 0x0002;      // treasury, incomes, expenses, loans
+inline constexpr uint32_t production = 0x0004;  // factories, rgos, construction
+inline constexpr uint32_t prices = 0x0008;      // markets, supply and demand
+inline constexpr uint32_t population = 0x0010;  // pops and everything aggregated from them
+inline constexpr uint32_t diplomacy = 0x0020;   // relations, influence, wars, crises, cbs
+inline constexpr uint32_t politics = 0x0040;    // parties, reforms, elections, movements, rebels, decisions
+inline constexpr uint32_t technology = 0x0080;  // research and inventions
+inline constexpr uint32_t military = 0x0100;    // units, leaders, battles, sieges, army groups
+inline constexpr uint32_t selection = 0x0200;   // the player's current unit / regiment / army group selection
+
+inline constexpr uint32_t game_tick = date | budget | production | prices | population | diplomacy | politics | technology | military;
+inline constexpr uint32_t all = 0xFFFFFFFF;
+}
+
 class element_base;
 
 xy_pair child_relative_location(sys::state& state, element_base const& parent, element_base const& child);
@@ -410,6 +428,8 @@ struct state {
 	bool scrollbar_continuous_movement = false;
 	float last_fps = 0.f;
 	bool lazy_load_in_game = false;
+	uint32_t update_channels = update_channel::all; // channels touched since the last game state update, only narrowed while it is being propagated
+	std::vector<bool> preloaded_windows; // indexed by the first child of a window definition (see preload_window_textures)
 	element_base* scroll_target = nullptr;
 	element_base* drag_target = nullptr;
 	element_base* edit_target = nullptr;
@@ -532,6 +552,9 @@ constexpr ui_hook_fn hook() {
 
 void populate_definitions_map(sys::state& state);
 void make_size_from_graphics(sys::state& state, ui::element_data& dat);
+// the preload manifest of a window: the textures its images and buttons (and those of its sub windows) will draw
+void collect_window_textures(sys::state& state, ui::element_data const& window, std::vector<dcon::texture_id>& out);
+void preload_window_textures(sys::state& state, ui::element_data const& window); // queues the manifest with the texture streamer, once per definition
 std::unique_ptr<element_base> make_element(sys::state& state, std::string_view name);
 std::unique_ptr<element_base> make_element_immediate(sys::state& state, dcon::gui_def_id id); // bypasses global map
 
@@ -298,8 +298,10 @@ protected:
 public:
 	void on_update(sys::state& state) noexcept override {
 		row_contents.clear();
+		// sorted on the published snapshot, so that the keys cannot change under std::sort while a tick is running
+		auto const& snapshot = state.ui_snapshots.front();
 		state.world.for_each_nation([&](dcon::nation_id id) {
-			if(state.world.nation_get_owned_province_count(id) != 0)
+			if(snapshot.nation(id).owned_provinces != 0)
 				row_contents.push_back(id);
 		});
 		auto lsort = retrieve<ledger_sort>(state, parent);
@@ -308,45 +310,45 @@ public:
 			case ledger_sort_type::country_status:
 				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 					if(lsort.reversed) {
-						return int32_t(nations::get_status(state, a)) >  int32_t(nations::get_status(state, b));
+						return int32_t(snapshot.nation(a).status) >  int32_t(snapshot.nation(b).status);
 					} else {
-						return int32_t(nations::get_status(state, a)) < int32_t(nations::get_status(state, b));
+						return int32_t(snapshot.nation(a).status) < int32_t(snapshot.nation(b).status);
 					}
 				});
 				break;
 			case ledger_sort_type::military_score:
 				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 					if(lsort.reversed) {
-						return state.world.nation_get_military_score(a) < state.world.nation_get_military_score(b);
+						return snapshot.nation(a).military_score < snapshot.nation(b).military_score;
 					} else {
-						return state.world.nation_get_military_score(a) > state.world.nation_get_military_score(b);
+						return snapshot.nation(a).military_score > snapshot.nation(b).military_score;
 					}
 				});
 				break;
 			case ledger_sort_type::industrial_score:
 				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 					if(lsort.reversed) {
-						return state.world.nation_get_industrial_score(a) < state.world.nation_get_industrial_score(b);
+						return snapshot.nation(a).industrial_score < snapshot.nation(b).industrial_score;
 					} else {
-						return state.world.nation_get_industrial_score(a) > state.world.nation_get_industrial_score(b);
+						return snapshot.nation(a).industrial_score > snapshot.nation(b).industrial_score;
 					}
 				});
 				break;
 			case ledger_sort_type::prestige:
 				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 					if(lsort.reversed) {
-						return nations::prestige_score(state, a) < nations::prestige_score(state, b);
+						return snapshot.nation(a).prestige < snapshot.nation(b).prestige;
 					} else {
-						return nations::prestige_score(state, a) > nations::prestige_score(state, b);
+						return snapshot.nation(a).prestige > snapshot.nation(b).prestige;
 					}
 				});
 				break;
 			case ledger_sort_type::total_score:
 				std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 					if(lsort.reversed) {
-						return state.world.nation_get_military_score(a) + state.world.nation_get_industrial_score(a) + nations::prestige_score(state, a) < state.world.nation_get_military_score(b) + state.world.nation_get_industrial_score(b) + nations::prestige_score(state, b);
+						return snapshot.nation(a).military_score + snapshot.nation(a).industrial_score + snapshot.nation(a).prestige < snapshot.nation(b).military_score + snapshot.nation(b).industrial_score + snapshot.nation(b).prestige;
 					} else {
-						return state.world.nation_get_military_score(a) + state.world.nation_get_industrial_score(a) + nations::prestige_score(state, a) > state.world.nation_get_military_score(b) + state.world.nation_get_industrial_score(b) + nations::prestige_score(state, b);
+						return snapshot.nation(a).military_score + snapshot.nation(a).industrial_score + snapshot.nation(a).prestige > snapshot.nation(b).military_score + snapshot.nation(b).industrial_score + snapshot.nation(b).prestige;
 					}
 				});
 				break;
@@ -560,8 +562,9 @@ protected:
 public:
 	void on_update(sys::state& state) noexcept override {
 		row_contents.clear();
+		auto const& snapshot = state.ui_snapshots.front();
 		state.world.for_each_nation([&](dcon::nation_id id) {
-			if(state.world.nation_get_owned_province_count(id) != 0)
+			if(snapshot.nation(id).owned_provinces != 0)
 				row_contents.push_back(id);
 		});
 
@@ -571,18 +574,18 @@ public:
 		case ledger_sort_type::total_pop:
 			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 				if(lsort.reversed) {
-					return state.world.nation_get_demographics(a, demographics::total) < state.world.nation_get_demographics(b, demographics::total);
+					return snapshot.nation(a).population < snapshot.nation(b).population;
 				} else {
-					return state.world.nation_get_demographics(a, demographics::total) > state.world.nation_get_demographics(b, demographics::total);
+					return snapshot.nation(a).population > snapshot.nation(b).population;
 				}
 			});
 			break;
 		case ledger_sort_type::provinces:
 			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
 				if(lsort.reversed) {
-					return state.world.nation_get_owned_province_count(a) < state.world.nation_get_owned_province_count(b);
+					return snapshot.nation(a).owned_provinces < snapshot.nation(b).owned_provinces;
 				} else {
-					return state.world.nation_get_owned_province_count(a) > state.world.nation_get_owned_province_count(b);
+					return snapshot.nation(a).owned_provinces > snapshot.nation(b).owned_provinces;
 				}
 			});
 			break;
@@ -609,8 +612,8 @@ public:
 			break;
 		case ledger_sort_type::literacy:
 			std::sort(row_contents.begin(), row_contents.end(), [&](dcon::nation_id a, dcon::nation_id b) {
-				auto aliteracy = state.world.nation_get_demographics(a, demographics::literacy) / std::max(1.0f, state.world.nation_get_demographics(a, demographics::total));
-				auto bliteracy = state.world.nation_get_demographics(b, demographics::literacy) / std::max(1.0f, state.world.nation_get_demographics(b, demographics::total));
+				auto aliteracy = snapshot.nation(a).literacy;
+				auto bliteracy = snapshot.nation(b).literacy;
 				if(lsort.reversed) {
 					return aliteracy < bliteracy;
 				} else {
@@ -2332,6 +2335,10 @@ class ledger_window : public window_element_base {
 	nation_toggle_list nation_toggle_status;
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::game_tick;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
 
@@ -142,6 +142,14 @@ struct save_item {
 		return file_name.starts_with(NATIVE("bookmark_"));
 	}
 
+	bool is_loading(sys::state& state) const { // the save picker's background load is reading this item
+		if(!state.save_load.active())
+			return false;
+		if(is_new_game)
+			return state.save_load.kind == sys::load_kind::scenario_as_save;
+		return state.save_load.kind == sys::load_kind::save && state.save_load.name == file_name;
+	}
+
 	bool operator==(save_item const& o) const {
 		return save_flag == o.save_flag && as_gov == o.as_gov && save_date == o.save_date && is_new_game == o.is_new_game && file_name == o.file_name && timestamp == o.timestamp;
 	}
@@ -150,6 +158,104 @@ struct save_item {
 	}
 };
 
+// called by the ui thread every frame; applies the save picker's load once the worker has prepared it
+inline void finish_save_load(sys::state& state) {
+	auto& bl = state.save_load;
+	if(!bl.done())
+		return;
+	bl.finish();
+	bool is_new_game = bl.kind == sys::load_kind::scenario_as_save;
+
+	if(bl.progress.stage.load(std::memory_order::acquire) == sys::load_stage::cancelled) {
+		bl.load = sys::prepared_load{};
+		state.game_state_updated.store(true, std::memory_order_release);
+		return;
+	}
+
+	window::change_cursor(state, window::cursor_type::busy); //show busy cursor so player doesn't question
+	if(state.ui_state.request_window)
+		static_cast<ui::diplomacy_request_window*>(state.ui_state.request_window)->messages.clear();
+	if(state.ui_state.msg_window)
+		static_cast<ui::message_window*>(state.ui_state.msg_window)->messages.clear();
+	if(state.ui_state.request_topbar_listbox)
+		static_cast<ui::diplomatic_message_topbar_listbox*>(state.ui_state.request_topbar_listbox)->messages.clear();
+	if(state.ui_state.msg_log_window)
+		static_cast<ui::message_log_window*>(state.ui_state.msg_log_window)->messages.clear();
+	for(const auto& win : land_combat_end_popup::land_reports_pool)
+		win->set_visible(state, false);
+	for(const auto& win : naval_combat_end_popup::naval_reports_pool)
+		win->set_visible(state, false);
+	ui::clear_event_windows(state);
+
+	state.network_state.save_slock.store(true, std::memory_order::release);
+	std::vector<dcon::nation_id> players;
+	for(const auto n : state.world.in_nation)
+		if(state.world.nation_get_is_player_controlled(n))
+			players.push_back(n);
+	dcon::nation_id old_local_player_nation = state.local_player_nation;
+	state.preload();
+	bool loaded = false;
+	if(is_new_game) {
+		if(!bl.prepared || !sys::apply_prepared_load(state, bl.load)) {
+			auto msg = std::string("Scenario file ") + simple_fs::native_to_utf8(bl.name) + " could not be loaded.";
+			ui::popup_error_window(state, "Scenario Error", msg);
+		} else {
+			loaded = true;
+		}
+	} else {
+		if(!bl.prepared || !sys::apply_prepared_load(state, bl.load)) {
+			auto msg = std::string("Save file ") + simple_fs::native_to_utf8(bl.name) + " could not be loaded.";
+			ui::popup_error_window(state, "Save Error", msg);
+			state.save_list_updated.store(true, std::memory_order::release); //update savefile list
+			//try loading save from scenario so we atleast have something to work on
+			if(!sys::try_read_scenario_as_save_file(state, state.loaded_scenario_file)) {
+				auto msg2 = std::string("Scenario file ") + simple_fs::native_to_utf8(state.loaded_scenario_file) + " could not be loaded.";
+				ui::popup_error_window(state, "Scenario Error", msg2);
+			} else {
+				loaded = true;
+			}
+		} else {
+			loaded = true;
+		}
+	}
+	bl.load = sys::prepared_load{}; // the decompressed sections are no longer needed
+	if(loaded) {
+		/* Updating this flag lets the network state know that we NEED to send the
+		savefile data, otherwise it is safe to assume the client has its own data
+		friendly reminder that, scenario loading and reloading ends up with different outcomes */
+		state.network_state.is_new_game = false;
+		if(state.network_mode == sys::network_mode_type::host) {
+			/* Save the buffer before we fill the unsaved data */
+			state.local_player_nation = dcon::nation_id{ };
+			network::place_host_player_after_saveload(state);
+
+			network::write_network_save(state);
+			state.fill_unsaved_data();
+
+			assert(state.world.nation_get_is_player_controlled(state.local_player_nation));
+			/* Now send the saved buffer before filling the unsaved data to the clients
+			henceforth. */
+			command::payload c;
+			memset(&c, 0, sizeof(command::payload));
+			c.type = command::command_type::notify_save_loaded;
+			c.source = state.local_player_nation;
+			c.data.notify_save_loaded.target = dcon::nation_id{};
+			network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length, state.network_state.current_save_checksum);
+		} else {
+			state.fill_unsaved_data();
+		}
+	}
+	/* Savefiles might load with new railroads, so for responsiveness we
+	   update whenever one is loaded. */
+	state.map_state.set_selected_province(dcon::province_id{});
+	state.map_state.unhandled_province_selection = true;
+	state.railroad_built.store(true, std::memory_order::release);
+	state.network_state.save_slock.store(false, std::memory_order::release);
+	state.game_state_updated.store(true, std::memory_order_release);
+
+	window::change_cursor(state, window::cursor_type::normal); //normal cursor now
+}
+
 class select_save_game : public button_element_base {
 public:
 	void on_create(sys::state& state) noexcept override {
@@ -159,95 +265,36 @@ public:
 
 	void button_action(sys::state& state) noexcept override {
 		save_item* i = retrieve< save_item*>(state, parent);
+		if(state.save_load.active()) { // one load at a time; clicking the item being loaded again cancels it
+			if(i->is_loading(state))
+				state.save_load.cancel();
+			return;
+		}
 		if(!i->is_new_game && i->file_name == state.loaded_save_file)
 			return;
 
-		window::change_cursor(state, window::cursor_type::busy); //show busy cursor so player doesn't question
-		if(state.ui_state.request_window)
-			static_cast<ui::diplomacy_request_window*>(state.ui_state.request_window)->messages.clear();
-		if(state.ui_state.msg_window)
-			static_cast<ui::message_window*>(state.ui_state.msg_window)->messages.clear();
-		if(state.ui_state.request_topbar_listbox)
-			static_cast<ui::diplomatic_message_topbar_listbox*>(state.ui_state.request_topbar_listbox)->messages.clear();
-		if(state.ui_state.msg_log_window)
-			static_cast<ui::message_log_window*>(state.ui_state.msg_log_window)->messages.clear();
-		for(const auto& win : land_combat_end_popup::land_reports_pool)
-			win->set_visible(state, false);
-		for(const auto& win : naval_combat_end_popup::naval_reports_pool)
-			win->set_visible(state, false);
-		ui::clear_event_windows(state);
-
-		state.network_state.save_slock.store(true, std::memory_order::release);
-		std::vector<dcon::nation_id> players;
-		for(const auto n : state.world.in_nation)
-			if(state.world.nation_get_is_player_controlled(n))
-				players.push_back(n);
-		dcon::nation_id old_local_player_nation = state.local_player_nation;
-		state.preload();
-		bool loaded = false;
-		if(i->is_new_game) {
-			if(!sys::try_read_scenario_as_save_file(state, state.loaded_scenario_file)) {
-				auto msg = std::string("Scenario file ") + simple_fs::native_to_utf8(state.loaded_scenario_file) + " could not be loaded.";
-				ui::popup_error_window(state, "Scenario Error", msg);
-			} else {
-				loaded = true;
-			}
-		} else {
-			if(!sys::try_read_save_file(state, i->file_name)) {
-				auto msg = std::string("Save file ") + simple_fs::native_to_utf8(i->file_name) + " could not be loaded.";
-				ui::popup_error_window(state, "Save Error", msg);
-				state.save_list_updated.store(true, std::memory_order::release); //update savefile list
-				//try loading save from scenario so we atleast have something to work on
-				if(!sys::try_read_scenario_as_save_file(state, state.loaded_scenario_file)) {
-					auto msg2 = std::string("Scenario file ") + simple_fs::native_to_utf8(state.loaded_scenario_file) + " could not be loaded.";
-					ui::popup_error_window(state, "Scenario Error", msg2);
-				} else {
-					loaded = true;
-				}
-			} else {
-				loaded = true;
-			}
-		}
-		if(loaded) {
-			/* Updating this flag lets the network state know that we NEED to send the
-			savefile data, otherwise it is safe to assume the client has its own data
-			friendly reminder that, scenario loading and reloading ends up with different outcomes */
-			state.network_state.is_new_game = false;
-			if(state.network_mode == sys::network_mode_type::host) {
-				/* Save the buffer before we fill the unsaved data */
-				state.local_player_nation = dcon::nation_id{ };
-				network::place_host_player_after_saveload(state);
-
-				network::write_network_save(state);
-				state.fill_unsaved_data();
-
-				assert(state.world.nation_get_is_player_controlled(state.local_player_nation));
-				/* Now send the saved buffer before filling the unsaved data to the clients
-				henceforth. */
-				command::payload c;
-				memset(&c, 0, sizeof(command::payload));
-				c.type = command::command_type::notify_save_loaded;
-				c.source = state.local_player_nation;
-				c.data.notify_save_loaded.target = dcon::nation_id{};
-				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length, state.network_state.current_save_checksum);
-			} else {
-				state.fill_unsaved_data();
-			}
-		}
-		/* Savefiles might load with new railroads, so for responsiveness we
-		   update whenever one is loaded. */
-		state.map_state.set_selected_province(dcon::province_id{});
-		state.map_state.unhandled_province_selection = true;
-		state.railroad_built.store(true, std::memory_order::release);
-		state.network_state.save_slock.store(false, std::memory_order::release);
+		// reading and decompressing the file does not touch the world, so it happens on a worker thread while the game
+		// and the ui keep running; finish_save_load applies it once it is ready
+		if(i->is_new_game)
+			state.save_load.start(state.loaded_scenario_file, sys::load_kind::scenario_as_save);
+		else
+			state.save_load.start(i->file_name, sys::load_kind::save);
 		state.game_state_updated.store(true, std::memory_order_release);
-
-		window::change_cursor(state, window::cursor_type::normal); //normal cursor now
 	}
 	void on_update(sys::state& state) noexcept override {
 		save_item* i = retrieve< save_item*>(state, parent);
 		frame = i->file_name == state.loaded_save_file ? 1 : 0;
 	}
+
+	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
+		return tooltip_behavior::variable_tooltip;
+	}
+
+	void update_tooltip(sys::state& state, int32_t x, int32_t y, text::columnar_layout& contents) noexcept override {
+		save_item* i = retrieve< save_item*>(state, parent);
+		if(i->is_loading(state))
+			text::add_line(state, contents, "alice_loading_cancel");
+	}
 };
 
 class save_flag : public button_element_base {
@@ -295,7 +342,7 @@ public:
 			if(gfx_def.type_dependent) {
 				auto mask_handle = ogl::get_texture_handle(state, dcon::texture_id(gfx_def.type_dependent - 1), true);
 				auto& mask_tex = state.open_gl.asset_textures[dcon::texture_id(gfx_def.type_dependent - 1)];
-				ogl::render_masked_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+				ogl::render_masked_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 					float(x) + float(base_data.size.x - mask_tex.size_x) * 0.5f,
 					float(y) + float(base_data.size.y - mask_tex.size_y) * 0.5f,
 					float(mask_tex.size_x),
@@ -303,7 +350,7 @@ public:
 					flag_texture_handle, mask_handle, base_data.get_rotation(), gfx_def.is_vertically_flipped(),
 					false);
 			} else {
-				ogl::render_textured_rect(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
+				ogl::render_flag(state, get_color_modification(this == state.ui_state.under_mouse, disabled, interactable),
 					float(x), float(y), float(base_data.size.x), float(base_data.size.y), flag_texture_handle, base_data.get_rotation(),
 					gfx_def.is_vertically_flipped(),
 					false);
@@ -332,10 +379,24 @@ public:
 };
 
 class save_date : public simple_text_element_base {
+	bool showing_progress = false;
 public:
 	void on_update(sys::state& state) noexcept override {
 		save_item* i = retrieve< save_item*>(state, parent);
 		set_text(state, text::date_to_string(state, i->save_date));
+		showing_progress = false;
+	}
+	void render(sys::state& state, int32_t x, int32_t y) noexcept override {
+		save_item* i = retrieve< save_item*>(state, parent);
+		if(i->is_loading(state)) {
+			text::substitution_map sub{};
+			text::add_to_substitution_map(sub, text::variable_type::value, text::fp_percentage_one_place{ state.save_load.progress.fraction.load(std::memory_order::acquire) });
+			set_text(state, text::resolve_string_substitution(state, "alice_loading_save", sub));
+			showing_progress = true;
+		} else if(showing_progress) {
+			on_update(state);
+		}
+		simple_text_element_base::render(state, x, y);
 	}
 };
 
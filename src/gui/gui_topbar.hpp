@@ -44,7 +44,7 @@ public:
 class topbar_nation_prestige_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, std::to_string(int32_t(nations::prestige_score(state, retrieve<dcon::nation_id>(state, parent)))));
+		set_text(state, std::to_string(int32_t(state.ui_snapshots.front().nation(retrieve<dcon::nation_id>(state, parent)).prestige)));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -185,9 +185,7 @@ public:
 
 	void on_update(sys::state& state) noexcept override {
 		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto literacy = state.world.nation_get_demographics(n, demographics::literacy);
-		auto total_pop = std::max(1.0f, state.world.nation_get_demographics(n, demographics::total));
-		set_text(state, text::format_percentage(literacy / total_pop, 1));
+		set_text(state, text::format_percentage(state.ui_snapshots.front().nation(n).literacy, 1));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -219,7 +217,7 @@ public:
 		expanded_hitbox_text::on_create(state);
 	}
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_float(state.world.nation_get_infamy(retrieve<dcon::nation_id>(state, parent)), 2));
+		set_text(state, text::format_float(state.ui_snapshots.front().nation(retrieve<dcon::nation_id>(state, parent)).infamy, 2));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -246,7 +244,7 @@ class topbar_nation_population_text : public multiline_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
 		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto total_pop = state.world.nation_get_demographics(n, demographics::total);
+		auto total_pop = state.ui_snapshots.front().nation(n).population;
 
 		auto pop_amount = state.player_data_cache.population_record[state.ui_date.value % 32];
 		auto pop_change = state.ui_date.value <= 32
@@ -304,7 +302,7 @@ public:
 		auto previous_day_record = state.player_data_cache.treasury_record[(state.ui_date.value + 31) % 32];
 		auto change = current_day_record - previous_day_record;
 
-		text::add_to_layout_box(state, layout, box, text::prettify_currency(nations::get_treasury(state, n)));
+		text::add_to_layout_box(state, layout, box, text::prettify_currency(state.ui_snapshots.front().nation(n).treasury));
 		text::add_to_layout_box(state, layout, box, std::string(" ("));
 		if(change > 0) {
 			text::add_to_layout_box(state, layout, box, std::string("+"), text::text_color::green);
@@ -1502,15 +1500,11 @@ public:
 
 			state.world.for_each_decision([&](dcon::decision_id di) {
 				if(nation_id != state.local_player_nation || !state.world.decision_get_hide_notification(di)) {
-					auto lim = state.world.decision_get_potential(di);
-					if(!lim || trigger::evaluate(state, lim, trigger::to_generic(nation_id), trigger::to_generic(nation_id), 0)) {
-						auto allow = state.world.decision_get_allow(di);
-						if(!allow || trigger::evaluate(state, allow, trigger::to_generic(nation_id), trigger::to_generic(nation_id), 0)) {
-							auto fat_id = dcon::fatten(state.world, di);
-							auto box = text::open_layout_box(contents);
-							text::add_to_layout_box(state, contents, box, fat_id.get_name(), m);
-							text::close_layout_box(contents, box);
-						}
+					if(state.world.nation_get_allowed_decisions(nation_id, di)) {
+						auto fat_id = dcon::fatten(state.world, di);
+						auto box = text::open_layout_box(contents);
+						text::add_to_layout_box(state, contents, box, fat_id.get_name(), m);
+						text::close_layout_box(contents, box);
 					}
 				}
 			});
@@ -2079,7 +2079,7 @@ public:
 				state.selected_armies.clear();
 				state.selected_navies.clear();
 				set_visible(state, false);
-				state.game_state_updated.store(true, std::memory_order_release);
+				state.mark_ui_dirty(ui::update_channel::selection);
 				break;
 			}
 			case unitpanel_action::upgrade: {
@@ -2154,7 +2154,7 @@ public:
 	void button_action(sys::state& state) noexcept override {
 		state.selected_armies.clear();
 		state.selected_navies.clear();
-		state.game_state_updated.store(true, std::memory_order_release);
+		state.mark_ui_dirty(ui::update_channel::selection);
 	}
 };
 
@@ -2993,7 +2993,7 @@ class toggle_defend_order_button : public button_element_base {
 			state.selected_army_group_order = sys::army_group_order::defend;
 		}
 		on_update(state);
-		state.game_state_updated.store(true, std::memory_order_release);
+		state.mark_ui_dirty(ui::update_channel::selection);
 	}
 
 	void on_update(sys::state& state) noexcept override {
@@ -3022,7 +3022,7 @@ class toggle_enforce_control_order_button : public button_element_base {
 		}
 
 		on_update(state);
-		state.game_state_updated.store(true, std::memory_order_release);
+		state.mark_ui_dirty(ui::update_channel::selection);
 	}
 
 	void on_update(sys::state& state) noexcept override {
@@ -3050,7 +3050,7 @@ class toggle_ferry_origin_order_button : public button_element_base {
 			state.selected_army_group_order = sys::army_group_order::designate_port;
 		}
 		on_update(state);
-		state.game_state_updated.store(true, std::memory_order_release);
+		state.mark_ui_dirty(ui::update_channel::selection);
 	}
 
 	void on_update(sys::state& state) noexcept override {
@@ -1940,6 +1940,10 @@ private:
 	budget_repay_loan_window* budget_repay_loan_win = nullptr;
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::budget | update_channel::prices;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
 
@@ -2198,6 +2198,10 @@ private:
 
 public:
 
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::diplomacy | update_channel::military | update_channel::politics;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		generic_tabbed_window::on_create(state);
 		state.ui_state.diplomacy_subwindow = this;
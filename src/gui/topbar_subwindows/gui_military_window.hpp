@@ -180,6 +180,10 @@ public:
 
 class military_window : public window_element_base {
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::military | update_channel::diplomacy;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
 		state.ui_state.military_subwindow = this;
@@ -585,6 +585,10 @@ private:
 	dcon::nation_id release_nation_id{};
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::politics | update_channel::population;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		generic_tabbed_window::on_create(state);
 		{
@@ -2563,6 +2563,10 @@ private:
 	}
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::population | update_channel::politics;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
 		set_visible(state, false);
@@ -1947,6 +1947,10 @@ class production_window : public generic_tabbed_window<production_window_tab> {
 	}
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::production | update_channel::prices | update_channel::population | update_channel::budget;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		generic_tabbed_window::on_create(state);
 
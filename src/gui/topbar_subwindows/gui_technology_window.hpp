@@ -775,6 +775,10 @@ class technology_window : public generic_tabbed_window<culture::tech_category> {
 	dcon::technology_id tech_id{};
 	invention_sort_type invention_sort = invention_sort_type::type;
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::technology;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		generic_tabbed_window::on_create(state);
 
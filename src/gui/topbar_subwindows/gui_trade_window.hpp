@@ -1533,6 +1533,10 @@ class trade_window : public window_element_base {
 	table::display<dcon::market_id>* table_trade_good_stats_market = nullptr;
 
 public:
+	uint32_t update_channels(sys::state& state) noexcept override {
+		return update_channel::prices | update_channel::production;
+	}
+
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
 
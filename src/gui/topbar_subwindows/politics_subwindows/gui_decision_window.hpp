@@ -346,8 +346,7 @@ private:
 		for(uint32_t i = state.world.decision_size(); i-- > 0;) {
 			dcon::decision_id did{ dcon::decision_id::value_base_t(i) };
 			if(!state.cheat_data.always_potential_decisions) {
-				auto lim = state.world.decision_get_potential(did);
-				if(!lim || trigger::evaluate(state, lim, trigger::to_generic(n), trigger::to_generic(n), 0)) {
+				if(state.world.nation_get_potential_decisions(n, did)) {
 					list.push_back(did);
 				}
 			} else {
@@ -356,10 +355,8 @@ private:
 		}
 
 		std::sort(list.begin(), list.end(), [&](dcon::decision_id a, dcon::decision_id b) {
-			auto allow_a = state.world.decision_get_allow(a);
-			auto allow_b = state.world.decision_get_allow(b);
-			auto a_res = !allow_a || trigger::evaluate(state, allow_a, trigger::to_generic(n), trigger::to_generic(n), 0);
-			auto b_res = !allow_b || trigger::evaluate(state, allow_b, trigger::to_generic(n), trigger::to_generic(n), 0);
+			auto a_res = state.world.nation_get_allowed_decisions(n, a);
+			auto b_res = state.world.nation_get_allowed_decisions(n, b);
 			if(a_res != b_res)
 				return a_res;
 			else
@@ -984,9 +984,20 @@ native_string to_hex(uint64_t v) {
 void make_mod_file() {
 	file_is_ready.store(false, std::memory_order::memory_order_seq_cst);
 	auto path = produce_mod_path();
-	std::thread file_maker([path]() {
+	auto existing_file = selected_scenario_file;
+	std::thread file_maker([path, existing_file]() {
 		simple_fs::file_system fs_root;
 		simple_fs::restore_state(fs_root, path);
+
+		// nothing the scenario is built from has changed since the existing file was made: keep it
+		auto previous = existing_file.empty() ? std::vector<char>{} : sys::read_scenario_input_manifest(existing_file);
+		auto inputs = sys::make_scenario_input_manifest(fs_root, previous);
+		if(!existing_file.empty() && sys::changed_scenario_inputs(previous.data(), previous.size(), inputs).empty()) {
+			file_is_ready.store(true, std::memory_order::memory_order_release);
+			InvalidateRect((HWND)(m_hwnd), nullptr, FALSE);
+			return;
+		}
+
 		parsers::error_handler err("");
 		auto root = get_root(fs_root);
 		auto common = open_directory(root, NATIVE("common"));
@@ -1023,6 +1034,7 @@ void make_mod_file() {
 				++max_scenario_count;
 				selected_scenario_file = base_name + NATIVE("-") + std::to_wstring(append) + NATIVE(".bin");
 				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+				sys::write_scenario_input_manifest(selected_scenario_file, inputs);
 				if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 					auto content = view_contents(*of);
 					auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
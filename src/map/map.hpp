@@ -300,6 +300,11 @@ public:
 	void gen_prov_color_texture(GLuint texture_handle, std::vector<uint32_t> const& prov_color, uint8_t layers = 1);
 
 	void create_curved_river_vertices(parsers::scenario_building_context& context, std::vector<uint8_t> const& river_data, std::vector<uint8_t> const& terrain_data);
+
+	// border, coastline and river meshes are kept in the scenario directory, keyed by a hash of everything they are traced from
+	sys::checksum_key border_mesh_key(sys::state& state, std::vector<uint8_t> const& river_data) const;
+	bool load_border_mesh_cache(sys::checksum_key const& key);
+	void save_border_mesh_cache(sys::checksum_key const& key) const;
 };
 
 void load_river_crossings(parsers::scenario_building_context& context, std::vector<uint8_t> const& river_data, glm::ivec2 map_size);
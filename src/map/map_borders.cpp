@@ -3,6 +3,7 @@
 #include "province.hpp"
 #include "system_state.hpp"
 #include "parsers_declarations.hpp"
+#include "blake2.h"
 
 namespace map {
 enum direction : uint8_t {
@@ -118,121 +119,227 @@ int32_t get_border_index(uint16_t map_province_id1, uint16_t map_province_id2, p
 void display_data::load_border_data(parsers::scenario_building_context& context) {
 	border_vertices.clear();
 
-	glm::vec2 map_size(size_x, size_y);
-
 	diagonal_borders = std::vector<uint8_t>(size_x * size_y, 0);
 
-	// The borders of the current row and last row
-	for(uint32_t y = 0; y < size_y - 1; y++) {
-		for(uint32_t x = 0; x < size_x - 1; x++) {
-			auto prov_id_ul = province_id_map[(x + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[(x + 1) + (y + 0) * size_x];
-			auto prov_id_dl = province_id_map[(x + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[(x + 1) + (y + 1) * size_x];
+	auto const first_sea = province::to_map_id(context.state.province_definitions.first_sea_province);
 
-			if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
-				diagonal_borders[(x + 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-			}
-			if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
-				diagonal_borders[(x + 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
-			}
-			if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
-				diagonal_borders[x + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-			}
-			if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
-				diagonal_borders[x + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
+	// Classifies the 2x2 window whose upper left pixel is (x, y); xr is the column to its right (which wraps at the date line).
+	// Only rows y and y + 1 of diagonal_borders are written
+	auto classify_window = [&](uint32_t x, uint32_t xr, uint32_t y) {
+		auto prov_id_ul = province_id_map[x + (y + 0) * size_x];
+		auto prov_id_ur = province_id_map[xr + (y + 0) * size_x];
+		auto prov_id_dl = province_id_map[x + (y + 1) * size_x];
+		auto prov_id_dr = province_id_map[xr + (y + 1) * size_x];
+
+		if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
+			diagonal_borders[xr + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_LEFT);
+		}
+		if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
+			diagonal_borders[xr + y * size_x] |= uint8_t(diagonal_border::DOWN_LEFT);
+		}
+		if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
+			diagonal_borders[x + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_RIGHT);
+		}
+		if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
+			diagonal_borders[x + y * size_x] |= uint8_t(diagonal_border::DOWN_RIGHT);
+		}
+		if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
+			if((prov_id_ul >= first_sea || prov_id_ul == 0) && (prov_id_ur < first_sea && prov_id_ur != 0)) {
+				diagonal_borders[x + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_RIGHT);
+				diagonal_borders[xr + y * size_x] |= uint8_t(diagonal_border::DOWN_LEFT);
+			} else if((prov_id_ur >= first_sea || prov_id_ur == 0) && (prov_id_ul < first_sea && prov_id_ul != 0)) {
+				diagonal_borders[xr + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_LEFT);
+				diagonal_borders[x + y * size_x] |= uint8_t(diagonal_border::DOWN_RIGHT);
 			}
-			if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
-				if((prov_id_ul >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ul == 0)
-					&& (prov_id_ur < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ur != 0)) {
+		}
+	};
+	auto classify_row = [&](uint32_t y) {
+		for(uint32_t x = 0; x < size_x - 1; x++) {
+			classify_window(x, x + 1, y);
+		}
+		classify_window(size_x - 1, 0, y); // the international date line
+	};
 
-					diagonal_borders[x + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-					diagonal_borders[(x + 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
+	// rows of windows are classified in parallel; a row writes its own pixel row and the next one, so even and odd rows
+	// of windows take turns to keep the writes of concurrent rows apart
+	uint32_t const window_rows = size_y - 1;
+	concurrency::parallel_for(uint32_t(0), (window_rows + 1) / 2, [&](uint32_t i) {
+		classify_row(i * 2);
+	});
+	concurrency::parallel_for(uint32_t(0), window_rows / 2, [&](uint32_t i) {
+		classify_row(i * 2 + 1);
+	});
 
-				} else if((prov_id_ur >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ur == 0)
-					&& (prov_id_ul < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ul != 0)) {
+	// Adjacencies are gathered per row in parallel, then created in the same order as a serial scan would, so that
+	// adjacency ids do not depend on the scheduling
+	constexpr uint64_t clear_non_adjacent = uint64_t(1) << 32;
+	std::vector<std::vector<uint64_t>> row_adjacencies(window_rows);
+	concurrency::parallel_for(uint32_t(0), window_rows, [&](uint32_t y) {
+		auto& out = row_adjacencies[y];
+		auto add = [&](uint16_t a, uint16_t b, uint64_t flags) {
+			auto v = (uint64_t(a) << 16) | uint64_t(b) | flags;
+			if(out.empty() || out.back() != v)
+				out.push_back(v);
+		};
+		auto gather_window = [&](uint32_t x, uint32_t xr, uint64_t flags) {
+			auto prov_id_ul = province_id_map[x + (y + 0) * size_x];
+			auto prov_id_ur = province_id_map[xr + (y + 0) * size_x];
+			auto prov_id_dl = province_id_map[x + (y + 1) * size_x];
+			auto prov_id_dr = province_id_map[xr + (y + 1) * size_x];
+			if(prov_id_ul == 0)
+				return;
+			if(prov_id_ul != prov_id_ur && prov_id_ur != 0)
+				add(prov_id_ul, prov_id_ur, flags);
+			if(prov_id_ul != prov_id_dl && prov_id_dl != 0)
+				add(prov_id_ul, prov_id_dl, flags);
+			if(prov_id_ul != prov_id_dr && prov_id_dr != 0)
+				add(prov_id_ul, prov_id_dr, flags);
+		};
+		for(uint32_t x = 0; x < size_x - 1; x++) {
+			gather_window(x, x + 1, clear_non_adjacent);
+		}
+		gather_window(size_x - 1, 0, 0); // the date line only creates adjacencies
+	});
 
-					diagonal_borders[(x + 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-					diagonal_borders[x + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-				}
+	for(auto& row : row_adjacencies) {
+		for(auto v : row) {
+			auto a = province::from_map_id(uint16_t((v >> 16) & 0xFFFF));
+			auto b = province::from_map_id(uint16_t(v & 0xFFFF));
+			context.state.world.try_create_province_adjacency(a, b);
+			if((v & clear_non_adjacent) != 0) {
+				auto aval = context.state.world.get_province_adjacency_by_province_pair(a, b);
+				if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
+					context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
 			}
+		}
+	}
+}
 
-			if(prov_id_ul != prov_id_ur || prov_id_ul != prov_id_dl || prov_id_ul != prov_id_dr) {
-				if(prov_id_ul != prov_id_ur && prov_id_ur != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
+namespace {
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-						context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-				if(prov_id_ul != prov_id_dl && prov_id_dl != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
+struct border_mesh_cache_header {
+	static constexpr uint32_t current_version = 1;
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-							context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-				if(prov_id_ul != prov_id_dr && prov_id_dr != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
+	uint32_t version = current_version;
+	uint32_t border_count = 0;
+	uint32_t border_vertex_count = 0;
+	uint32_t coastal_vertex_count = 0;
+	uint32_t coastal_loop_count = 0;
+	uint32_t river_vertex_count = 0;
+	uint32_t river_count = 0;
+	sys::checksum_key sources;
+};
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-						context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-			}
-		}
+native_string border_mesh_cache_name(sys::checksum_key const& key) {
+	static char const digits[] = "0123456789abcdef";
+	native_string name = NATIVE("map_meshes_");
+	for(uint32_t i = 0; i < 8; ++i) {
+		name.push_back(native_char(digits[key.key[i] >> 4]));
+		name.push_back(native_char(digits[key.key[i] & 0x0F]));
+	}
+	return name + NATIVE(".bin");
+}
 
-		{
-			// handle the international date line
-			auto prov_id_ul = province_id_map[((size_x - 1) + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[0 + (y + 0) * size_x];
-			auto prov_id_dl = province_id_map[((size_x - 1) + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[0 + (y + 1) * size_x];
+template<typename T>
+void append_pod_vector(std::vector<char>& out, std::vector<T> const& v) {
+	auto start = out.size();
+	out.resize(start + v.size() * sizeof(T));
+	if(!v.empty())
+		std::memcpy(out.data() + start, v.data(), v.size() * sizeof(T));
+}
 
-			if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
-				diagonal_borders[0 + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-			}
-			if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
-				diagonal_borders[0 + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
-			}
-			if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
-				diagonal_borders[(size_x - 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-			}
-			if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
-				diagonal_borders[(size_x - 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-			}
-			if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
-				if((prov_id_ul >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ul == 0)
-					&& (prov_id_ur < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ur != 0)) {
+template<typename T>
+void read_pod_vector(char const*& in, std::vector<T>& v, uint32_t count) {
+	v.resize(count);
+	if(count != 0)
+		std::memcpy(v.data(), in, count * sizeof(T));
+	in += count * sizeof(T);
+}
 
-					diagonal_borders[(size_x - 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-					diagonal_borders[0 + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
+} // namespace
 
-				} else if((prov_id_ur >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ur == 0)
-					&& (prov_id_ul < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ul != 0)) {
+sys::checksum_key display_data::border_mesh_key(sys::state& state, std::vector<uint8_t> const& river_data) const {
+	// everything the border, coastline and river passes read: the maps, the land/sea split and the adjacencies by index
+	std::vector<uint32_t> adjacencies;
+	adjacencies.reserve(state.world.province_adjacency_size() * 2);
+	for(auto adj : state.world.in_province_adjacency) {
+		adjacencies.push_back(uint32_t(adj.get_connected_provinces(0).id.index()));
+		adjacencies.push_back(uint32_t(adj.get_connected_provinces(1).id.index()));
+	}
+	uint32_t const scalars[] = { border_mesh_cache_header::current_version, size_x, size_y, uint32_t(state.province_definitions.first_sea_province.index()) };
+
+	blake2b_state hasher;
+	blake2b_init(&hasher, sizeof(sys::checksum_key));
+	blake2b_update(&hasher, scalars, sizeof(scalars));
+	blake2b_update(&hasher, province_id_map.data(), province_id_map.size() * sizeof(uint16_t));
+	blake2b_update(&hasher, river_data.data(), river_data.size());
+	blake2b_update(&hasher, terrain_id_map.data(), terrain_id_map.size());
+	blake2b_update(&hasher, adjacencies.data(), adjacencies.size() * sizeof(uint32_t));
+
+	sys::checksum_key key;
+	blake2b_final(&hasher, &key, sizeof(key));
+	return key;
+}
 
-					diagonal_borders[0 + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-					diagonal_borders[(size_x - 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-				}
-			}
+bool display_data::load_border_mesh_cache(sys::checksum_key const& key) {
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	auto file = simple_fs::open_file(dir, border_mesh_cache_name(key));
+	if(!file)
+		return false;
+	auto content = simple_fs::view_contents(*file);
 
-			if(prov_id_ul != prov_id_ur || prov_id_ul != prov_id_dl || prov_id_ul != prov_id_dr) {
+	border_mesh_cache_header header;
+	if(content.file_size < sizeof(header))
+		return false;
+	std::memcpy(&header, content.data, sizeof(header));
+	if(header.version != border_mesh_cache_header::current_version || !header.sources.is_equal(key))
+		return false;
+	auto expected_size = sizeof(header)
+		+ uint64_t(header.border_count) * sizeof(border)
+		+ uint64_t(header.border_vertex_count) * sizeof(textured_line_vertex_b)
+		+ uint64_t(header.coastal_vertex_count) * sizeof(textured_line_vertex_b)
+		+ uint64_t(header.coastal_loop_count) * (sizeof(GLint) + sizeof(GLsizei))
+		+ uint64_t(header.river_vertex_count) * sizeof(textured_line_with_width_vertex)
+		+ uint64_t(header.river_count) * (sizeof(GLint) + sizeof(GLsizei));
+	if(uint64_t(content.file_size) != expected_size)
+		return false;
 
-				if(prov_id_ul != prov_id_ur && prov_id_ur != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
-				}
-				if(prov_id_ul != prov_id_dl && prov_id_dl != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
-				}
-				if(prov_id_ul != prov_id_dr && prov_id_dr != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
-				}
-			}
-		}
-	}
+	char const* in = content.data + sizeof(header);
+	read_pod_vector(in, borders, header.border_count);
+	read_pod_vector(in, border_vertices, header.border_vertex_count);
+	read_pod_vector(in, coastal_vertices, header.coastal_vertex_count);
+	read_pod_vector(in, coastal_starts, header.coastal_loop_count);
+	read_pod_vector(in, coastal_counts, header.coastal_loop_count);
+	read_pod_vector(in, river_vertices, header.river_vertex_count);
+	read_pod_vector(in, river_starts, header.river_count);
+	read_pod_vector(in, river_counts, header.river_count);
+	return true;
+}
+
+void display_data::save_border_mesh_cache(sys::checksum_key const& key) const {
+	border_mesh_cache_header header;
+	header.border_count = uint32_t(borders.size());
+	header.border_vertex_count = uint32_t(border_vertices.size());
+	header.coastal_vertex_count = uint32_t(coastal_vertices.size());
+	header.coastal_loop_count = uint32_t(coastal_starts.size());
+	header.river_vertex_count = uint32_t(river_vertices.size());
+	header.river_count = uint32_t(river_starts.size());
+	header.sources = key;
+	assert(coastal_counts.size() == coastal_starts.size() && river_counts.size() == river_starts.size());
+
+	std::vector<char> out(sizeof(header));
+	std::memcpy(out.data(), &header, sizeof(header));
+	append_pod_vector(out, borders);
+	append_pod_vector(out, border_vertices);
+	append_pod_vector(out, coastal_vertices);
+	append_pod_vector(out, coastal_starts);
+	append_pod_vector(out, coastal_counts);
+	append_pod_vector(out, river_vertices);
+	append_pod_vector(out, river_starts);
+	append_pod_vector(out, river_counts);
+
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	simple_fs::write_file(dir, border_mesh_cache_name(key), out.data(), uint32_t(out.size()));
 }
 
 bool is_river(uint8_t river_data) {
@@ -372,7 +372,8 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 		auto terrain_resolution = internal_make_index_map();
 
 		if(terrain_data.size_x == int32_t(size_x) && terrain_data.size_y == int32_t(size_y)) {
-			for(uint32_t ty = 0; ty < size_y; ++ty) {
+			// rows are independent: every pixel only reads the source image and writes its own entry
+			concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 				uint32_t y = size_y - ty - 1;
 				for(uint32_t x = 0; x < size_x; ++x) {
 
@@ -443,16 +444,17 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 
 					}
 				}
-			}
+			});
 		}
 	}
 
 	// Gets rid of any stray land terrain that has been painted outside the borders
-	for(uint32_t y = 0; y < size_y; ++y) {
+	auto const first_sea = province::to_map_id(context.state.province_definitions.first_sea_province);
+	concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t y) {
 		for(uint32_t x = 0; x < size_x; ++x) {
 			if(province_id_map[y * size_x + x] == 0) { // If there is no province define at that location
 				terrain_id_map[y * size_x + x] = uint8_t(255);
-			} else if(province_id_map[y * size_x + x] >= province::to_map_id(context.state.province_definitions.first_sea_province)) { // sea province
+			} else if(province_id_map[y * size_x + x] >= first_sea) { // sea province
 				terrain_id_map[y * size_x + x] = uint8_t(255);
 			} else { // land province
 				if(terrain_id_map[y * size_x + x] >= 64) {
@@ -460,7 +462,7 @@ void display_data::load_terrain_data(parsers::scenario_building_context& context
 				}
 			}
 		}
-	}
+	});
 
 	// Load the terrain
 	load_median_terrain_type(context);
@@ -521,45 +523,49 @@ void display_data::load_provinces_mid_point(parsers::scenario_building_context&
 	}
 }
 
+// Neighbouring pixels nearly always share a colour, so a lookup is only made where the colour changes along the row
+void resolve_province_row(ankerl::unordered_dense::map<uint32_t, dcon::province_id> const& colors, uint8_t const* pixels, uint16_t* out, uint32_t count) {
+	uint32_t last_color = 0;
+	uint16_t last_id = 0;
+	bool has_last = false;
+	for(uint32_t x = 0; x < count; ++x) {
+		uint8_t const* ptr = pixels + x * 4;
+		auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
+		if(!has_last || color != last_color) {
+			if(auto it = colors.find(color); it != colors.end()) {
+				assert(it->second);
+				last_id = province::to_map_id(it->second);
+			} else {
+				last_id = 0;
+			}
+			last_color = color;
+			has_last = true;
+		}
+		out[x] = last_id;
+	}
+}
+
 void display_data::load_province_data(parsers::scenario_building_context& context, ogl::image& image) {
 	uint32_t imsz = uint32_t(size_x * size_y);
+	auto const& colors = context.map_color_to_province_id;
 	if(!context.new_maps) {
 		auto free_space = std::max(uint32_t(0), size_y - image.size_y); // schombert: find out how much water we need to add
 		auto top_free_space = (free_space * 3) / 5;
 
 		province_id_map.resize(imsz);
-		uint32_t i = 0;
-		for(; i < top_free_space * size_x; ++i) { // schombert: fill with nothing until the start of the real data
-			province_id_map[i] = 0;
-		}
 		auto first_actual_map_pixel = top_free_space * size_x; // schombert: where the real data starts
-		for(; i < first_actual_map_pixel + image.size_x * image.size_y; ++i) {
-			uint8_t* ptr = image.data + (i - first_actual_map_pixel) * 4; // schombert: subtract to find our offset in the actual image data
-			auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
-			if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
-				assert(it->second);
-				province_id_map[i] = province::to_map_id(it->second);
-			} else {
-				province_id_map[i] = 0;
-			}
-		}
-		for(; i < imsz; ++i) { // schombert: fill remainder with nothing
-			province_id_map[i] = 0;
-		}
+		auto last_actual_map_pixel = first_actual_map_pixel + image.size_x * image.size_y;
+		std::fill(province_id_map.begin(), province_id_map.begin() + first_actual_map_pixel, uint16_t(0)); // schombert: fill with nothing until the start of the real data
+		concurrency::parallel_for(uint32_t(0), uint32_t(image.size_y), [&](uint32_t row) {
+			auto offset = row * uint32_t(image.size_x); // schombert: subtract to find our offset in the actual image data
+			resolve_province_row(colors, image.data + offset * 4, province_id_map.data() + first_actual_map_pixel + offset, uint32_t(image.size_x));
+		});
+		std::fill(province_id_map.begin() + last_actual_map_pixel, province_id_map.end(), uint16_t(0)); // schombert: fill remainder with nothing
 	} else {
 		province_id_map.resize(imsz);
-		for(uint32_t i = 0; i < imsz; ++i) {
-			auto map_x = i % size_x;
-			auto map_y = i / size_x;
-			uint8_t* ptr = image.data + (map_x + size_x * (size_y - map_y - 1)) * 4;
-			auto color = sys::pack_color(ptr[0], ptr[1], ptr[2]);
-			if(auto it = context.map_color_to_province_id.find(color); it != context.map_color_to_province_id.end()) {
-				assert(it->second);
-				province_id_map[i] = province::to_map_id(it->second);
-			} else {
-				province_id_map[i] = 0;
-			}
-		}
+		concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t map_y) {
+			resolve_province_row(colors, image.data + size_x * (size_y - map_y - 1) * 4, province_id_map.data() + map_y * size_x, size_x);
+		});
 	}
 
 	load_provinces_mid_point(context);
@@ -598,7 +604,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 		std::vector<bmp_pixel_data> color_table;
 		river_data = load_bmp(context, NATIVE("rivers.bmp"), size, 255, &color_table);
 
-		for(uint32_t ty = 0; ty < size_y; ++ty) {
+		concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 			//uint32_t y = size_y - ty - 1;
 			for(uint32_t x = 0; x < size_x; ++x) {
 				uint8_t color_index = river_data[x + size_x * ty];
@@ -617,7 +623,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 					river_data[ty * size_x + x] = std::min<uint8_t>((uint8_t)250, std::max<uint8_t>((uint8_t)2, r / 3 + g / 3 + b / 3));
 				}
 			}
-		}
+		});
 
 	} else {
 		auto river_file = simple_fs::open_file(map_dir, NATIVE("alice_rivers.png"));
@@ -630,7 +636,7 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 		auto terrain_resolution = internal_make_index_map();
 
 		if(river_image_data.size_x == int32_t(size_x) && river_image_data.size_y == int32_t(size_y)) {
-			for(uint32_t ty = 0; ty < size_y; ++ty) {
+			concurrency::parallel_for(uint32_t(0), size_y, [&](uint32_t ty) {
 				uint32_t y = size_y - ty - 1;
 
 				for(uint32_t x = 0; x < size_x; ++x) {
@@ -646,24 +652,31 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 						river_data[ty * size_x + x] = 255;
 
 				}
-			}
+			});
 		}
 	}
 
 
 	load_river_crossings(context, river_data, glm::vec2(float(size_x), float(size_y)));
 
-	create_curved_river_vertices(context, river_data, terrain_id_map);
-	{
+	auto mesh_key = border_mesh_key(context.state, river_data);
+	if(load_border_mesh_cache(mesh_key))
+		return;
+
+	// the three passes only read the map and the adjacencies, and each writes its own set of vertex buffers
+	concurrency::parallel_invoke([&]() {
+		create_curved_river_vertices(context, river_data, terrain_id_map);
+	}, [&]() {
 		std::vector<bool> borders_visited;
 		borders_visited.resize(size_x * size_y * 2, false);
 		make_coastal_borders(context.state, borders_visited);
-	}
-	{
+	}, [&]() {
 		std::vector<bool> borders_visited;
 		borders_visited.resize(size_x * size_y * 2, false);
 		make_borders(context.state, borders_visited);
-	}
+	});
+
+	save_border_mesh_cache(mesh_key);
 }
 
 // Called to load the terrain and province map data
@@ -44,6 +44,7 @@ std::vector<uint32_t> political_map_from(sys::state& state) {
 		}
 	});
 
+	auto const& snapshot = state.ui_snapshots.front();
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto fat_id = dcon::fatten(state.world, prov_id);
 		auto i = province::to_map_id(prov_id);
@@ -56,11 +57,11 @@ std::vector<uint32_t> political_map_from(sys::state& state) {
 			for(const auto adj : fat_id.get_province_adjacency_as_connected_provinces()) {
 				auto p2 = adj.get_connected_provinces(adj.get_connected_provinces(0) == prov_id ? 1 : 0);
 				if(p2.get_is_coast()) {
-					auto n = p2.get_province_control_as_province().get_nation();
+					auto n = snapshot.controller(p2.id);
 					if(!n || second_n == n || first_n == n)
 						continue;
-					if(!bool(second_n) || n.get_rank() > state.world.nation_get_rank(second_n)) {
-						if(!bool(first_n) || n.get_rank() > state.world.nation_get_rank(first_n)) {
+					if(!bool(second_n) || snapshot.nation(n).rank > snapshot.nation(second_n).rank) {
+						if(!bool(first_n) || snapshot.nation(n).rank > snapshot.nation(first_n).rank) {
 							second_n = first_n;
 							first_n = n;
 						} else {
@@ -79,15 +80,15 @@ std::vector<uint32_t> political_map_from(sys::state& state) {
 				}
 			}
 		} else {
-			auto id = fat_id.get_nation_from_province_ownership();
+			auto id = snapshot.owner(prov_id);
 			uint32_t color = 0;
 			if(bool(id)) {
-				color = nation_color[id.id.value];
+				color = nation_color[id.value];
 			} else { // If no owner use default color
 				color = 255 << 16 | 255 << 8 | 255;
 			}
-			auto occupier = fat_id.get_nation_from_province_control();
-			uint32_t color_b = occupier ? nation_color[occupier.id.value] :
+			auto occupier = snapshot.controller(prov_id);
+			uint32_t color_b = occupier ? nation_color[occupier.value] :
 				(id ? sys::pack_color(127, 127, 127) : sys::pack_color(255, 255, 255));
 
 			prov_color[i] = color;
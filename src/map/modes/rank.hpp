@@ -21,23 +21,23 @@ std::vector<uint32_t> rank_map_from(sys::state& state) {
 		}
 	}
 
+	auto const& snapshot = state.ui_snapshots.front();
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto fat_id = dcon::fatten(state.world, prov_id);
-
-		auto nation_id = fat_id.get_nation_from_province_ownership();
-		auto status = nations::get_status(state, nation_id);
+		auto nation_id = snapshot.owner(prov_id);
+		auto status = snapshot.nation(nation_id).status;
+		auto rank = snapshot.nation(nation_id).rank;
 
 		float darkness = 0.0f;
 		if(status == nations::status::great_power)
-			darkness = 1.0f - 0.7f * (state.world.nation_get_rank(nation_id)) / state.defines.great_nations_count;
+			darkness = 1.0f - 0.7f * (rank) / state.defines.great_nations_count;
 		else if(status == nations::status::secondary_power)
-			darkness = 1.0f - 0.7f * (state.world.nation_get_rank(nation_id) - state.defines.great_nations_count) /
+			darkness = 1.0f - 0.7f * (rank - state.defines.great_nations_count) /
 														(state.defines.colonial_rank - state.defines.great_nations_count);
 		else if(status == nations::status::civilized)
-			darkness = 1.0f - 0.7f * (state.world.nation_get_rank(nation_id) - state.defines.colonial_rank) /
+			darkness = 1.0f - 0.7f * (rank - state.defines.colonial_rank) /
 														std::max(1.0f, (float(unciv_rank) - state.defines.colonial_rank));
 		else
-			darkness = 1.0f - 0.7f * (state.world.nation_get_rank(nation_id) - unciv_rank) /
+			darkness = 1.0f - 0.7f * (rank - unciv_rank) /
 														std::max(1.0f, (float(num_nations) - float(unciv_rank)));
 
 		uint32_t color;
@@ -1439,17 +1439,42 @@ bool has_reform_available(sys::state& state, dcon::nation_id n) {
 	return false;
 }
 
+void update_decision_availability(sys::state& state) {
+	concurrency::parallel_for(uint32_t(0), state.world.decision_size(), [&](uint32_t i) {
+		dcon::decision_id did{ dcon::decision_id::value_base_t(i) };
+		auto potential = state.world.decision_get_potential(did);
+		auto allow = state.world.decision_get_allow(did);
+
+		ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
+			ve::mask_vector is_potential = potential
+				? trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0)
+				: ve::mask_vector{ true };
+			ve::mask_vector is_allowed = is_potential;
+			if(allow && ve::compress_mask(is_potential).v != 0) {
+				is_allowed = is_potential && trigger::evaluate(state, allow, trigger::to_generic(ids), trigger::to_generic(ids), 0);
+			}
+			state.world.nation_set_potential_decisions(ids, did, is_potential);
+			state.world.nation_set_allowed_decisions(ids, did, is_allowed);
+		});
+	});
+}
+
+void update_decision_availability(sys::state& state, dcon::nation_id n) {
+	for(auto d : state.world.in_decision) {
+		auto potential = d.get_potential();
+		auto allow = d.get_allow();
+		bool is_potential = !potential || trigger::evaluate(state, potential, trigger::to_generic(n), trigger::to_generic(n), 0);
+		bool is_allowed = is_potential && (!allow || trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0));
+		state.world.nation_set_potential_decisions(n, d.id, is_potential);
+		state.world.nation_set_allowed_decisions(n, d.id, is_allowed);
+	}
+}
+
 bool has_decision_available(sys::state& state, dcon::nation_id n) {
 	for(uint32_t i = state.world.decision_size(); i-- > 0;) {
 		dcon::decision_id did{dcon::decision_id::value_base_t(i)};
-		if(!state.world.decision_get_hide_notification(did)) {
-			auto lim = state.world.decision_get_potential(did);
-			if(!lim || trigger::evaluate(state, lim, trigger::to_generic(n), trigger::to_generic(n), 0)) {
-				auto allow = state.world.decision_get_allow(did);
-				if(!allow || trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0)) {
-					return true;
-				}
-			}
+		if(!state.world.decision_get_hide_notification(did) && state.world.nation_get_allowed_decisions(n, did)) {
+			return true;
 		}
 	}
 	return false;
@@ -320,6 +320,9 @@ uint32_t get_total_pop_in_owned_provinces(sys::state& state, dcon::nation_id n);
 bool has_political_reform_available(sys::state& state, dcon::nation_id n);
 bool has_social_reform_available(sys::state& state, dcon::nation_id n);
 bool has_reform_available(sys::state& state, dcon::nation_id n);
+// refreshes the potential_decisions / allowed_decisions bits of every nation; allowed implies potential
+void update_decision_availability(sys::state& state);
+void update_decision_availability(sys::state& state, dcon::nation_id n);
 bool has_decision_available(sys::state& state, dcon::nation_id n);
 int32_t max_national_focuses(sys::state& state, dcon::nation_id n);
 int32_t national_focuses_in_use(sys::state& state, dcon::nation_id n);
@@ -698,6 +698,9 @@
 	LUA_DEFINES_LIST_ELEMENT(alice_substate_subject_money_transfer, 40.0)                                                          \
 	LUA_DEFINES_LIST_ELEMENT(alice_puppet_subject_money_transfer, 30.0)                                                          \
 	LUA_DEFINES_LIST_ELEMENT(alice_privateinvestment_subject_transfer, 2.0)                                                          \
+	LUA_DEFINES_LIST_ELEMENT(alice_full_modifier_recreation, 0.0)                                                          \
+	LUA_DEFINES_LIST_ELEMENT(alice_reorder_trigger_clauses, 0.0)                                                           \
+	LUA_DEFINES_LIST_ELEMENT(alice_trigger_memo_budget, 0.0)                                                               \
 
 
 // scales the needs values so that they are needs per this many pops
@@ -1,3 +1,4 @@
+#include <cstring>
 #include "parsers.hpp"
 
 namespace parsers {
@@ -27,6 +28,71 @@ inline double pow_10(int n) {
 	return e[n];
 }
 
+// SWAR digit handling, after fast_float: eight ascii digits are checked and combined in a single little-endian word
+inline bool is_eight_digits(uint64_t v) {
+	return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+inline uint32_t eight_digits_value(uint64_t v) {
+	uint64_t const mask = 0x000000FF000000FF;
+	uint64_t const mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+	uint64_t const mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+	v -= 0x3030303030303030;
+	v = (v * 10) + (v >> 8);
+	return uint32_t((((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32);
+}
+// consumes whole groups of eight digits
+inline char const* accumulate_eight_digit_groups(char const* start, char const* end, uint64_t& accumulated) {
+	while(end - start >= 8) {
+		uint64_t v = 0;
+		std::memcpy(&v, start, 8);
+		if(!is_eight_digits(v))
+			break;
+		accumulated = accumulated * 100000000 + eight_digits_value(v);
+		start += 8;
+	}
+	return start;
+}
+// reads digits until the first non digit, returning where it stopped
+// the word-at-a-time check only pays for itself on long runs, so short ones go straight to the byte loop
+inline char const* accumulate_digits(char const* start, char const* end, uint64_t& accumulated) {
+	if(end - start >= 12)
+		start = accumulate_eight_digit_groups(start, end, accumulated);
+	for(; start < end && *start >= '0' && *start <= '9'; ++start) {
+		accumulated = accumulated * 10 + uint64_t(*start - '0');
+	}
+	return start;
+}
+// digits, optionally followed by a '.' and more digits, with no more than 18 digits in all so that nothing can overflow
+// anything else is left to the general loops, which produce exactly the same values for these inputs
+inline bool plain_decimal(char const* start, char const* end, int64_t& accumulated, int32_t& magnitude) {
+	uint64_t acc = 0;
+	auto position = accumulate_digits(start, end, acc);
+	auto digits = position - start;
+	int32_t fraction_digits = 0;
+	if(position < end && *position == '.') {
+		++position;
+		auto fraction_end = accumulate_digits(position, end, acc);
+		fraction_digits = int32_t(fraction_end - position);
+		position = fraction_end;
+	}
+	if(position != end || digits + fraction_digits > 18)
+		return false;
+	accumulated = int64_t(acc);
+	magnitude = fraction_digits;
+	return true;
+}
+
+bool int_from_chars(char const* start, char const* end, int32_t& int_out) {
+	bool is_negative = start < end && *start == '-';
+	if(is_negative)
+		++start;
+	uint64_t acc = 0;
+	if(start == end || end - start > 9 || accumulate_digits(start, end, acc) != end)
+		return false;
+	int_out = is_negative ? -int32_t(acc) : int32_t(acc);
+	return true;
+}
+
 bool float_from_chars(char const* start, char const* end, float& float_out) { // returns true on success
 	// first read the chars into an int, keeping track of the magnitude
 	// multiply by a pow of 10
@@ -48,14 +114,16 @@ bool float_from_chars(char const* start, char const* end, float& float_out) { //
 		++start;
 	}
 
-	for(; start < end; ++start) {
-		if(*start >= '0' && *start <= '9') {
-			accumulated = accumulated * 10 + (*start - '0');
-			magnitude += int32_t(after_decimal);
-		} else if(*start == '.') {
-			after_decimal = true;
-		} else {
-			// maybe check for non space and throw an error?
+	if(!plain_decimal(start, end, accumulated, magnitude)) {
+		for(; start < end; ++start) {
+			if(*start >= '0' && *start <= '9') {
+				accumulated = accumulated * 10 + (*start - '0');
+				magnitude += int32_t(after_decimal);
+			} else if(*start == '.') {
+				after_decimal = true;
+			} else {
+				// maybe check for non space and throw an error?
+			}
 		}
 	}
 	if(!is_negative) {
@@ -90,13 +158,15 @@ bool double_from_chars(char const* start, char const* end, double& dbl_out) { //
 		++start;
 	}
 
-	for(; start < end; ++start) {
-		if(*start >= '0' && *start <= '9') {
-			accumulated = accumulated * 10 + (*start - '0');
-			magnitude += int32_t(after_decimal);
-		} else if(*start == '.') {
-			after_decimal = true;
-		} else {
+	if(!plain_decimal(start, end, accumulated, magnitude)) {
+		for(; start < end; ++start) {
+			if(*start >= '0' && *start <= '9') {
+				accumulated = accumulated * 10 + (*start - '0');
+				magnitude += int32_t(after_decimal);
+			} else if(*start == '.') {
+				after_decimal = true;
+			} else {
+			}
 		}
 	}
 	if(!is_negative) {
@@ -225,6 +225,8 @@ double parse_double(std::string_view content, int32_t line, error_handler& err)
 
 int32_t parse_int(std::string_view content, int32_t line, error_handler& err) {
 	int32_t rvalue = 0;
+	if(int_from_chars(content.data(), content.data() + content.length(), rvalue))
+		return rvalue;
 	auto result = std::from_chars(content.data(), content.data() + content.length(), rvalue);
 	if(result.ec == std::errc::invalid_argument) {
 		err.bad_int(content, line);
@@ -113,6 +113,7 @@ public:
 
 bool float_from_chars(char const* start, char const* end, float& float_out); // returns true on success
 bool double_from_chars(char const* start, char const* end, double& dbl_out); // returns true on success
+bool int_from_chars(char const* start, char const* end, int32_t& int_out); // only an optional '-' and up to nine digits; false for anything else
 
 std::string_view remove_surrounding_whitespace(std::string_view txt);
 
@@ -10,6 +10,7 @@
 #include "script_constants.hpp"
 #include "nations.hpp"
 #include "nations_templates.hpp"
+#include <deque>
 
 namespace effect {
 
@@ -116,12 +117,11 @@ uint32_t es_x_neighbor_province_scope(EFFECT_PARAMTERS) {
 	}
 }
 
-std::vector<dcon::province_id> country_get_province_adjacency(sys::state &state, dcon::nation_id nat_id) {
-	std::vector<dcon::province_id> v;
+void country_get_province_adjacency(sys::state& state, dcon::nation_id nat_id, std::vector<dcon::province_id>& v) {
+	v.clear();
 
 	for(auto own : state.world.nation_get_province_ownership(nat_id)) {
 		auto prov = own.get_province().id;
-		auto neighbor_range = state.world.province_get_province_adjacency(prov);
 
 		for(auto adj : state.world.province_get_province_adjacency(prov)) {
 			if((adj.get_type() & (province::border::impassible_bit | province::border::coastal_bit)) == 0) {
@@ -131,13 +131,48 @@ std::vector<dcon::province_id> country_get_province_adjacency(sys::state &state,
 					v.push_back(other.id);
 				}
 			}
-		}		
+		}
 	}
-
+}
+std::vector<dcon::province_id> country_get_province_adjacency(sys::state &state, dcon::nation_id nat_id) {
+	std::vector<dcon::province_id> v;
+	country_get_province_adjacency(state, nat_id, v);
 	return v;
 }
+
+/*
+* Scope effects nest, so each nesting level borrows its own province list from a per thread pool instead of allocating a
+* fresh vector on every execution. A deque keeps the lists handed out to the outer levels in place as the pool grows.
+*/
+struct province_list_pool {
+	std::deque<std::vector<dcon::province_id>> lists;
+	uint32_t in_use = 0;
+};
+thread_local province_list_pool scratch_province_lists;
+
+class borrowed_province_list {
+public:
+	std::vector<dcon::province_id>& list;
+
+	borrowed_province_list() : list(acquire()) { }
+	~borrowed_province_list() {
+		--scratch_province_lists.in_use;
+	}
+	borrowed_province_list(borrowed_province_list const&) = delete;
+	borrowed_province_list& operator=(borrowed_province_list const&) = delete;
+
+private:
+	static std::vector<dcon::province_id>& acquire() {
+		if(scratch_province_lists.lists.size() <= scratch_province_lists.in_use)
+			scratch_province_lists.lists.emplace_back();
+		return scratch_province_lists.lists[scratch_province_lists.in_use++];
+	}
+};
+
 uint32_t es_x_neighbor_province_scope_nation(EFFECT_PARAMTERS) {
-	auto neighbor_range = country_get_province_adjacency(ws, trigger::to_nation(primary_slot));
+	borrowed_province_list neighbors;
+	country_get_province_adjacency(ws, trigger::to_nation(primary_slot), neighbors.list);
+	auto const& neighbor_range = neighbors.list;
 
 
 	// random_
@@ -187,7 +222,9 @@ uint32_t es_x_neighbor_province_scope_nation(EFFECT_PARAMTERS) {
 	}
 }
 uint32_t es_x_empty_neighbor_province_scope_nation(EFFECT_PARAMTERS) {
-	auto neighbor_range = country_get_province_adjacency(ws, trigger::to_nation(primary_slot));
+	borrowed_province_list neighbors;
+	country_get_province_adjacency(ws, trigger::to_nation(primary_slot), neighbors.list);
+	auto const& neighbor_range = neighbors.list;
 
 	// random_
 	if((tval[0] & effect::is_random_scope) != 0) {
@@ -282,27 +319,176 @@ uint32_t es_x_neighbor_country_scope(EFFECT_PARAMTERS) {
 		}
 	}
 }
+/*
+* Nation-wide scopes (every country, every other country, ...) evaluate their limit a whole vector of nations at a time with the
+* vectorized trigger evaluator. When every member of such a scope is a plain value write on the scope target itself, the members
+* are applied as masked vector writes as well instead of re-dispatching the effect bytecode once per nation. In that case all
+* limits are evaluated before any member runs, which only differs from one-at-a-time execution for a limit that inspects another
+* nation's value written by the same scope.
+*/
+template<typename F>
+void for_each_nation_block_in_scope(sys::state& ws, uint16_t const* tval, dcon::nation_id excluded, bool require_provinces,
+		int32_t this_slot, int32_t from_slot, F&& f) {
+	auto const size = ws.world.nation_size();
+	auto limit = (tval[0] & effect::scope_has_limit) != 0 ? trigger::payload(tval[2]).tr_id : dcon::trigger_key{};
+	ve::tagged_vector<int32_t> this_vector;
+	for(uint32_t j = 0; j < ve::vector_size; ++j)
+		this_vector.set(j, this_slot);
+
+	ve::execute_serial_fast<dcon::nation_id>(size, [&](auto ids) {
+		ve::mask_vector in_scope = ve::apply(
+				[&](dcon::nation_id n) {
+					return uint32_t(n.index()) < size && n != excluded && (!require_provinces || ws.world.nation_get_owned_province_count(n) != 0);
+				},
+				ids);
+		if(limit && ve::compress_mask(in_scope).v != 0)
+			in_scope = in_scope && trigger::evaluate(ws, limit, trigger::to_generic(ids), this_vector, from_slot);
+		if(ve::compress_mask(in_scope).v != 0)
+			f(ids, in_scope);
+	});
+}
+
+void gather_nations_in_scope(sys::state& ws, uint16_t const* tval, dcon::nation_id excluded, bool require_provinces, int32_t this_slot,
+		int32_t from_slot, std::vector<dcon::nation_id>& out) {
+	for_each_nation_block_in_scope(ws, tval, excluded, require_provinces, this_slot, from_slot, [&](auto ids, ve::mask_vector in_scope) {
+		ve::apply(
+				[&](dcon::nation_id n, bool selected) {
+					if(selected)
+						out.push_back(n);
+				},
+				ids, in_scope);
+	});
+}
+
+bool is_batchable_nation_member(uint16_t const* e) {
+	switch(e[0] & effect::code_mask) {
+	case effect::set_country_flag:
+	case effect::clr_country_flag:
+	case effect::set_variable:
+	case effect::change_variable:
+	case effect::treasury:
+	case effect::war_exhaustion:
+	case effect::badboy:
+	case effect::prestige:
+	case effect::add_country_modifier:
+	case effect::add_country_modifier_no_duration:
+	case effect::remove_country_modifier:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool members_are_batchable_over_nations(uint16_t const* tval) {
+	auto const source_size = 1 + get_effect_scope_payload_size(tval);
+	auto sub_units_start = tval + 2 + effect_scope_data_payload(tval[0]);
+	if(sub_units_start >= tval + source_size)
+		return false;
+	while(sub_units_start < tval + source_size) {
+		if(!is_batchable_nation_member(sub_units_start))
+			return false;
+		sub_units_start += 1 + get_generic_effect_payload_size(sub_units_start);
+	}
+	return true;
+}
+
+template<typename T>
+void apply_batched_nation_member(uint16_t const* e, sys::state& ws, T ids, ve::mask_vector in_scope, int32_t this_slot, int32_t from_slot) {
+	switch(e[0] & effect::code_mask) {
+	case effect::set_country_flag:
+	{
+		auto flag = trigger::payload(e[1]).natf_id;
+		ws.world.nation_set_flag_variables(ids, flag, ws.world.nation_get_flag_variables(ids, flag) || in_scope);
+		break;
+	}
+	case effect::clr_country_flag:
+	{
+		auto flag = trigger::payload(e[1]).natf_id;
+		ws.world.nation_set_flag_variables(ids, flag, ws.world.nation_get_flag_variables(ids, flag) && !in_scope);
+		break;
+	}
+	case effect::set_variable:
+	{
+		auto v = trigger::payload(e[1]).natv_id;
+		auto amount = trigger::read_float_from_payload(e + 2);
+		assert(std::isfinite(amount));
+		ws.world.nation_set_variables(ids, v, ve::select(in_scope, ve::fp_vector{ amount }, ws.world.nation_get_variables(ids, v)));
+		break;
+	}
+	case effect::change_variable:
+	{
+		auto v = trigger::payload(e[1]).natv_id;
+		auto amount = trigger::read_float_from_payload(e + 2);
+		assert(std::isfinite(amount));
+		auto current = ws.world.nation_get_variables(ids, v);
+		ws.world.nation_set_variables(ids, v, ve::select(in_scope, current + amount, current));
+		break;
+	}
+	case effect::treasury:
+	{
+		auto amount = trigger::read_float_from_payload(e + 1);
+		assert(std::isfinite(amount));
+		auto current = ws.world.nation_get_stockpiles(ids, economy::money);
+		auto updated = ve::select(ws.world.nation_get_is_player_controlled(ids), current + amount, ve::max(current + amount, 0.0f));
+		ws.world.nation_set_stockpiles(ids, economy::money, ve::select(in_scope, updated, current));
+		break;
+	}
+	case effect::war_exhaustion:
+	{
+		auto amount = trigger::read_float_from_payload(e + 1);
+		assert(std::isfinite(amount));
+		auto current = ws.world.nation_get_war_exhaustion(ids);
+		ws.world.nation_set_war_exhaustion(ids, ve::select(in_scope, ve::min(ve::max(current + amount, 0.0f), 100.0f), current));
+		break;
+	}
+	case effect::badboy:
+	{
+		auto amount = trigger::read_float_from_payload(e + 1);
+		assert(std::isfinite(amount));
+		auto current = ws.world.nation_get_infamy(ids);
+		ws.world.nation_set_infamy(ids, ve::select(in_scope, ve::max(current + amount, 0.0f), current));
+		break;
+	}
+	default:
+		// members that go through shared bookkeeping (prestige, modifier lists) are applied one selected nation at a time
+		ve::apply(
+				[&](dcon::nation_id n, bool selected) {
+					if(selected) {
+						bool els = false;
+						internal_execute_effect(e, ws, trigger::to_generic(n), this_slot, from_slot, 0, 0, els);
+					}
+				},
+				ids, in_scope);
+		break;
+	}
+}
+
+uint32_t batched_nation_scope(uint16_t const* tval, sys::state& ws, dcon::nation_id excluded, bool require_provinces, int32_t this_slot,
+		int32_t from_slot) {
+	auto const source_size = 1 + get_effect_scope_payload_size(tval);
+	for_each_nation_block_in_scope(ws, tval, excluded, require_provinces, this_slot, from_slot, [&](auto ids, ve::mask_vector in_scope) {
+		auto sub_units_start = tval + 2 + effect_scope_data_payload(tval[0]);
+		while(sub_units_start < tval + source_size) {
+			apply_batched_nation_member(sub_units_start, ws, ids, in_scope, this_slot, from_slot);
+			sub_units_start += 1 + get_generic_effect_payload_size(sub_units_start);
+		}
+	});
+	// none of the batchable members draw random numbers
+	return 0;
+}
+
 uint32_t es_x_country_scope_nation(EFFECT_PARAMTERS) {
 	if((tval[0] & effect::is_random_scope) != 0) {
 		std::vector<dcon::nation_id> rlist;
-		if((tval[0] & effect::scope_has_limit) != 0) {
-			auto limit = trigger::payload(tval[2]).tr_id;
-			for(auto n : ws.world.in_nation) {
-				if(n.get_owned_province_count() != 0 && trigger::evaluate(ws, limit, trigger::to_generic(n.id), this_slot, from_slot))
-					rlist.push_back(n.id);
-			}
-		} else {
-			for(auto n : ws.world.in_nation) {
-				if(n.get_owned_province_count() != 0)
-					rlist.push_back(n.id);
-			}
-		}
+		gather_nations_in_scope(ws, tval, dcon::nation_id{}, true, this_slot, from_slot, rlist);
 
 		if(rlist.size() != 0) {
 			auto r = rng::get_random(ws, r_hi, r_lo) % rlist.size();
 			return 1 + apply_subeffects(tval, ws, trigger::to_generic(rlist[r]), this_slot, from_slot, r_hi, r_lo + 1, els);
 		}
 		return 0;
+	} else if(members_are_batchable_over_nations(tval)) {
+		return batched_nation_scope(tval, ws, dcon::nation_id{}, true, this_slot, from_slot);
 	} else {
 		uint32_t i = 0;
 		if((tval[0] & effect::scope_has_limit) != 0) {
@@ -323,23 +509,14 @@ uint32_t es_x_country_scope_nation(EFFECT_PARAMTERS) {
 uint32_t es_x_event_country_scope_nation(EFFECT_PARAMTERS) {
 	if((tval[0] & effect::is_random_scope) != 0) {
 		std::vector<dcon::nation_id> rlist;
-		if((tval[0] & effect::scope_has_limit) != 0) {
-			auto limit = trigger::payload(tval[2]).tr_id;
-			for(auto n : ws.world.in_nation) {
-				if(n != trigger::to_nation(primary_slot) && trigger::evaluate(ws, limit, trigger::to_generic(n.id), this_slot, from_slot))
-					rlist.push_back(n.id);
-			}
-		} else {
-			for(auto n : ws.world.in_nation) {
-				if(n != trigger::to_nation(primary_slot))
-					rlist.push_back(n.id);
-			}
-		}
+		gather_nations_in_scope(ws, tval, trigger::to_nation(primary_slot), false, this_slot, from_slot, rlist);
 		if(rlist.size() != 0) {
 			auto r = rng::get_random(ws, r_hi, r_lo) % rlist.size();
 			return 1 + apply_subeffects(tval, ws, trigger::to_generic(rlist[r]), this_slot, from_slot, r_hi, r_lo + 1, els);
 		}
 		return 0;
+	} else if(members_are_batchable_over_nations(tval)) {
+		return batched_nation_scope(tval, ws, trigger::to_nation(primary_slot), false, this_slot, from_slot);
 	} else {
 		uint32_t i = 0;
 		if((tval[0] & effect::scope_has_limit) != 0) {
@@ -360,23 +537,14 @@ uint32_t es_x_event_country_scope_nation(EFFECT_PARAMTERS) {
 uint32_t es_x_decision_country_scope_nation(EFFECT_PARAMTERS) {
 	if((tval[0] & effect::is_random_scope) != 0) {
 		std::vector<dcon::nation_id> rlist;
-		if((tval[0] & effect::scope_has_limit) != 0) {
-			auto limit = trigger::payload(tval[2]).tr_id;
-			for(auto n : ws.world.in_nation) {
-				if(n != trigger::to_nation(primary_slot) && n.get_owned_province_count() != 0 && trigger::evaluate(ws, limit, trigger::to_generic(n.id), this_slot, from_slot))
-					rlist.push_back(n.id);
-			}
-		} else {
-			for(auto n : ws.world.in_nation) {
-				if(n != trigger::to_nation(primary_slot) && n.get_owned_province_count() != 0)
-					rlist.push_back(n.id);
-			}
-		}
+		gather_nations_in_scope(ws, tval, trigger::to_nation(primary_slot), true, this_slot, from_slot, rlist);
 		if(rlist.size() != 0) {
 			auto r = rng::get_random(ws, r_hi, r_lo) % rlist.size();
 			return 1 + apply_subeffects(tval, ws, trigger::to_generic(rlist[r]), this_slot, from_slot, r_hi, r_lo + 1, els);
 		}
 		return 0;
+	} else if(members_are_batchable_over_nations(tval)) {
+		return batched_nation_scope(tval, ws, trigger::to_nation(primary_slot), true, this_slot, from_slot);
 	} else {
 		uint32_t i = 0;
 		if((tval[0] & effect::scope_has_limit) != 0) {
@@ -5405,12 +5573,15 @@ uint32_t internal_execute_effect(EFFECT_PARAMTERS) {
 
 void execute(sys::state& state, dcon::effect_key key, int32_t primary, int32_t this_slot, int32_t from_slot, uint32_t r_lo,
 		uint32_t r_hi) {
+	trigger::script_profile_scope profile_scope{ trigger::profile_counters(state, key), 1 };
+	trigger::invalidate_memo(state);
 	bool els = false;
 	internal_execute_effect(state.effect_data.data() + state.effect_data_indices[key.index() + 1], state, primary, this_slot, from_slot, r_lo, r_hi, els);
 }
 
 void execute(sys::state& state, uint16_t const* data, int32_t primary, int32_t this_slot, int32_t from_slot, uint32_t r_lo,
 		uint32_t r_hi) {
+	trigger::invalidate_memo(state);
 	bool els = false;
 	internal_execute_effect(data, state, primary, this_slot, from_slot, r_lo, r_hi, els);
 }
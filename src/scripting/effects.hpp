@@ -12,5 +12,7 @@ void execute(sys::state& state, uint16_t const* data, int32_t primary, int32_t t
 		uint32_t r_hi);
 
 std::vector<dcon::province_id> country_get_province_adjacency(sys::state& state, dcon::nation_id nat_id);
+// as above, but refills a caller owned buffer
+void country_get_province_adjacency(sys::state& state, dcon::nation_id nat_id, std::vector<dcon::province_id>& v);
 
 } // namespace effect
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include "triggers.hpp"
 #include "system_state.hpp"
 #include "demographics.hpp"
@@ -208,13 +211,26 @@ bool compare(ve::vbitfield_type a, ve::vbitfield_type b) {
 	return a.v == b.v;
 }
 
+template<typename T>
+void record_clause(sys::state& ws, uint16_t code, T sub_result) {
+	auto compressed = ve::compress_mask(sub_result);
+	if constexpr(std::is_same_v<decltype(compressed), bool>) {
+		ws.trigger_clause_statistics.record(code, 1, compressed ? 1 : 0);
+	} else {
+		ws.trigger_clause_statistics.record(code, uint32_t(std::popcount(uint32_t(full_mask<decltype(compressed)>::value.v))), uint32_t(std::popcount(uint32_t(compressed.v))));
+	}
+}
+
 TRIGGER_FUNCTION(apply_disjuctively) {
 	auto const source_size = 1 + get_trigger_scope_payload_size(tval);
 	auto sub_units_start = tval + 2 + trigger_scope_data_payload(tval[0]);
 
 	return_type result = return_type(false);
 	while(sub_units_start < tval + source_size) {
-		result = result | test_trigger_generic<return_type, primary_type, this_type, from_type>(sub_units_start, ws, primary_slot, this_slot, from_slot);
+		auto sub_result = test_trigger_generic<return_type, primary_type, this_type, from_type>(sub_units_start, ws, primary_slot, this_slot, from_slot);
+		if(ws.trigger_clause_statistics.collecting.load(std::memory_order_acquire))
+			record_clause(ws, sub_units_start[0], sub_result);
+		result = result | sub_result;
 		auto compressed_res = ve::compress_mask(result);
 		if(compare(compressed_res, full_mask<decltype(compressed_res)>::value))
 			return result;
@@ -229,7 +245,10 @@ TRIGGER_FUNCTION(apply_conjuctively) {
 
 	return_type result = return_type(true);
 	while(sub_units_start < tval + source_size) {
-		result = result & test_trigger_generic<return_type, primary_type, this_type, from_type>(sub_units_start, ws, primary_slot, this_slot, from_slot);
+		auto sub_result = test_trigger_generic<return_type, primary_type, this_type, from_type>(sub_units_start, ws, primary_slot, this_slot, from_slot);
+		if(ws.trigger_clause_statistics.collecting.load(std::memory_order_acquire))
+			record_clause(ws, sub_units_start[0], sub_result);
+		result = result & sub_result;
 		auto compressed_res = ve::compress_mask(result);
 		if(compare(compressed_res, empty_mask<decltype(compressed_res)>::value))
 			return result;
@@ -5806,6 +5825,7 @@ return_type CALLTYPE test_trigger_generic(uint16_t const* tval, sys::state& ws,
 #undef TRIGGER_FUNCTION
 
 float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), 1 };
 	auto base = state.value_modifiers[modifier];
 	float product = base.factor;
 	for(uint32_t i = 0; i < base.segments_count && product != 0; ++i) {
@@ -5820,6 +5840,7 @@ float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_k
 	return product;
 }
 float evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), 1 };
 	auto base = state.value_modifiers[modifier];
 	float sum = base.base;
 	for(uint32_t i = 0; i < base.segments_count; ++i) {
@@ -5834,7 +5855,10 @@ float evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key mod
 	return sum * base.factor;
 }
 
-ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+namespace {
+
+template<typename this_type>
+ve::fp_vector multiplicative_modifier_lanes(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, this_type this_slot, int32_t from_slot) {
 	auto base = state.value_modifiers[modifier];
 	ve::fp_vector product = base.factor;
 	for(uint32_t i = 0; i < base.segments_count; ++i) {
@@ -5847,7 +5871,8 @@ ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_mo
 	}
 	return product;
 }
-ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+template<typename this_type>
+ve::fp_vector additive_modifier_lanes(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, this_type this_slot, int32_t from_slot) {
 	auto base = state.value_modifiers[modifier];
 	ve::fp_vector sum = base.base;
 	for(uint32_t i = 0; i < base.segments_count; ++i) {
@@ -5861,34 +5886,139 @@ ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier
 	return sum * base.factor;
 }
 
+} // namespace
+
+ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(ve::vector_size) };
+	return multiplicative_modifier_lanes(state, modifier, primary, this_slot, from_slot);
+}
+ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(primary.subcount) };
+	return multiplicative_modifier_lanes(state, modifier, ve::contiguous_tags<int32_t>(primary.value), this_slot, from_slot);
+}
+ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(ve::vector_size) };
+	return additive_modifier_lanes(state, modifier, primary, this_slot, from_slot);
+}
+ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(primary.subcount) };
+	return additive_modifier_lanes(state, modifier, ve::contiguous_tags<int32_t>(primary.value), this_slot, from_slot);
+}
+
 ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot) {
-	auto base = state.value_modifiers[modifier];
-	ve::fp_vector product = base.factor;
-	for(uint32_t i = 0; i < base.segments_count; ++i) {
-		auto seg = state.value_modifier_segments[base.first_segment_offset + i];
-		if(seg.condition) {
-			auto res = test_trigger_generic<ve::mask_vector>(
-					state.trigger_data.data() + state.trigger_data_indices[seg.condition.index() + 1], state, primary, this_slot, from_slot);
-			product = ve::select(res, product * seg.factor, product);
-		}
-	}
-	return product;
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(ve::vector_size) };
+	return multiplicative_modifier_lanes(state, modifier, primary, this_slot, from_slot);
+}
+ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(primary.subcount) };
+	return multiplicative_modifier_lanes(state, modifier, ve::contiguous_tags<int32_t>(primary.value), ve::contiguous_tags<int32_t>(this_slot.value), from_slot);
 }
 ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot) {
-	auto base = state.value_modifiers[modifier];
-	ve::fp_vector sum = base.base;
-	for(uint32_t i = 0; i < base.segments_count; ++i) {
-		auto seg = state.value_modifier_segments[base.first_segment_offset + i];
-		if(seg.condition) {
-			auto res = test_trigger_generic<ve::mask_vector>(
-					state.trigger_data.data() + state.trigger_data_indices[seg.condition.index() + 1], state, primary, this_slot, from_slot);
-			sum = ve::select(res, sum + seg.factor, sum);
-		}
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(ve::vector_size) };
+	return additive_modifier_lanes(state, modifier, primary, this_slot, from_slot);
+}
+ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, modifier), uint32_t(primary.subcount) };
+	return additive_modifier_lanes(state, modifier, ve::contiguous_tags<int32_t>(primary.value), ve::contiguous_tags<int32_t>(this_slot.value), from_slot);
+}
+
+namespace {
+
+bool reads_date(uint16_t code) {
+	switch(code & code_mask) {
+	case year:
+	case month:
+	case truce_with_tag:
+	case truce_with_from:
+	case truce_with_this_nation:
+	case truce_with_this_province:
+	case truce_with_this_state:
+	case truce_with_this_pop:
+	case has_recently_lost_war:
+	case has_recently_lost_war_pop:
+	case election:
+	case has_recent_imigration:
+	case province_control_days:
+	case is_disarmed:
+	case is_disarmed_pop:
+		return true;
+	default:
+		return false;
 	}
-	return sum * base.factor;
+}
+
+bool memo_cacheable(sys::state& state, dcon::trigger_key key) {
+	auto& c = state.trigger_memo.classification;
+	if(c.size() != state.trigger_data_indices.size())
+		c.assign(state.trigger_data_indices.size(), uint8_t(0));
+	auto& v = c[key.index() + 1];
+	if(v == 0) {
+		bool dated = false;
+		recurse_over_triggers(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], [&](uint16_t* tval) {
+			if((tval[0] & code_mask) < first_scope_code)
+				dated = dated || reads_date(tval[0]);
+		});
+		v = dated ? uint8_t(2) : uint8_t(1);
+	}
+	return v == 1;
+}
+
+} // namespace
+
+memo_scope::memo_scope(sys::state& state) : state(state) {
+	auto& memo = state.trigger_memo;
+	if(state.defines.alice_trigger_memo_budget <= 0.0f)
+		return;
+	if(memo.depth != 0 && memo.owner != std::this_thread::get_id())
+		return;
+	if(memo.depth++ == 0) {
+		memo.owner = std::this_thread::get_id();
+		memo.active.store(true, std::memory_order_release);
+	}
+	opened = true;
+}
+memo_scope::~memo_scope() {
+	if(!opened)
+		return;
+	auto& memo = state.trigger_memo;
+	if(--memo.depth == 0) {
+		memo.active.store(false, std::memory_order_release);
+		memo.results.clear();
+	}
+}
+
+void invalidate_memo(sys::state& state) {
+	auto& memo = state.trigger_memo;
+	if(memo.active.load(std::memory_order_acquire) && memo.owner == std::this_thread::get_id() && !memo.results.empty()) {
+		memo.results.clear();
+		++memo.invalidations;
+	}
+}
+
+std::string memo_summary(sys::state& state) {
+	auto& memo = state.trigger_memo;
+	auto total = memo.hits + memo.misses;
+	return "trigger memo: " + std::to_string(memo.hits) + " hits, " + std::to_string(memo.misses) + " misses ("
+		+ std::to_string(total > 0 ? memo.hits * 100 / total : 0) + "% hit rate), " + std::to_string(memo.invalidations)
+		+ " invalidations by effects";
 }
 
 bool evaluate(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, key), 1 };
+	auto& memo = state.trigger_memo;
+	if(memo.active.load(std::memory_order_acquire) && memo.owner == std::this_thread::get_id() && memo_cacheable(state, key)) {
+		memo_cache::key_type k{ key, primary, this_slot, from_slot };
+		if(auto it = memo.results.find(k); it != memo.results.end()) {
+			++memo.hits;
+			return it->second;
+		}
+		++memo.misses;
+		bool result = test_trigger_generic<bool>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state, primary,
+			this_slot, from_slot);
+		if(memo.results.size() < size_t(state.defines.alice_trigger_memo_budget))
+			memo.results.insert_or_assign(k, result);
+		return result;
+	}
 	return test_trigger_generic<bool>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state, primary,
 			this_slot, from_slot);
 }
@@ -5896,8 +6026,18 @@ bool evaluate(sys::state& state, uint16_t const* data, int32_t primary, int32_t
 	return test_trigger_generic<bool>(data, state, primary, this_slot, from_slot);
 }
 
+namespace {
+
+// gathered primaries mark their empty lanes with -1
+uint32_t occupied_lanes(ve::tagged_vector<int32_t> primary) {
+	return uint32_t(std::popcount(uint32_t(ve::compress_mask(ve::apply([](int32_t v) { return v != -1; }, primary)).v)));
+}
+
+} // namespace
+
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguous_tags<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, key), uint32_t(ve::vector_size) };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
@@ -5905,9 +6045,17 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
 	return test_trigger_generic<ve::mask_vector>(data, state, primary, this_slot, from_slot);
 }
+ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::partial_contiguous_tags<int32_t> primary,
+		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, key), uint32_t(primary.subcount) };
+	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
+			ve::contiguous_tags<int32_t>(primary.value), this_slot, from_slot);
+}
 
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::tagged_vector<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot) {
+	auto counters = profile_counters(state, key);
+	script_profile_scope profile_scope{ counters, counters ? occupied_lanes(primary) : 0 };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
@@ -5918,6 +6066,7 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::tagged_vec
 
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguous_tags<int32_t> primary,
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, key), uint32_t(ve::vector_size) };
 	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
 			primary, this_slot, from_slot);
 }
@@ -5925,5 +6074,343 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot) {
 	return test_trigger_generic<ve::mask_vector>(data, state, primary, this_slot, from_slot);
 }
+ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::partial_contiguous_tags<int32_t> primary,
+		ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot) {
+	script_profile_scope profile_scope{ profile_counters(state, key), uint32_t(primary.subcount) };
+	return test_trigger_generic<ve::mask_vector>(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1], state,
+			ve::contiguous_tags<int32_t>(primary.value), ve::contiguous_tags<int32_t>(this_slot.value), from_slot);
+}
+
+void save_clause_statistics(sys::state& state) {
+	std::vector<uint64_t> buffer(clause_statistics_size * 2);
+	for(uint32_t i = 0; i < clause_statistics_size; ++i) {
+		buffer[i] = state.trigger_clause_statistics.evaluated[i].load(std::memory_order_relaxed);
+		buffer[clause_statistics_size + i] = state.trigger_clause_statistics.passed[i].load(std::memory_order_relaxed);
+	}
+	auto settings_location = simple_fs::get_or_create_settings_directory();
+	simple_fs::write_file(settings_location, NATIVE("trigger_clause_statistics.dat"), reinterpret_cast<char const*>(buffer.data()), uint32_t(buffer.size() * sizeof(uint64_t)));
+}
+
+void load_clause_statistics(sys::state& state) {
+	auto settings_location = simple_fs::get_or_create_settings_directory();
+	auto stats_file = simple_fs::open_file(settings_location, NATIVE("trigger_clause_statistics.dat"));
+	if(!stats_file)
+		return;
+	auto content = simple_fs::view_contents(*stats_file);
+	if(content.file_size != clause_statistics_size * 2 * sizeof(uint64_t)) // written by a build with different trigger codes
+		return;
+	for(uint32_t i = 0; i < clause_statistics_size; ++i) {
+		uint64_t e = 0;
+		uint64_t p = 0;
+		std::memcpy(&e, content.data + i * sizeof(uint64_t), sizeof(uint64_t));
+		std::memcpy(&p, content.data + (clause_statistics_size + i) * sizeof(uint64_t), sizeof(uint64_t));
+		state.trigger_clause_statistics.evaluated[i].store(e, std::memory_order_relaxed);
+		state.trigger_clause_statistics.passed[i].store(p, std::memory_order_relaxed);
+	}
+}
+
+namespace {
+
+// rough number of objects a scope iterates over, relative to a scope that just moves to a single other object
+float scope_fan_out(uint16_t code) {
+	switch(code & code_mask) {
+	case x_neighbor_province_scope:
+	case x_neighbor_country_scope_nation:
+	case x_neighbor_country_scope_pop:
+		return 6.0f;
+	case x_war_countries_scope_nation:
+	case x_war_countries_scope_pop:
+	case x_substate_scope:
+	case x_sphere_member_scope:
+	case x_owned_province_scope_state:
+		return 4.0f;
+	case x_greater_power_scope:
+		return 8.0f;
+	case x_core_scope_province:
+		return 2.0f;
+	case x_state_scope:
+	case x_neighbor_province_scope_state:
+	case x_provinces_in_variable_region:
+	case x_provinces_in_variable_region_proper:
+		return 10.0f;
+	case x_pop_scope_province:
+		return 15.0f;
+	case x_owned_province_scope_nation:
+	case x_core_scope_nation:
+		return 40.0f;
+	case x_pop_scope_state:
+		return 60.0f;
+	case x_country_scope:
+		return 100.0f;
+	case x_pop_scope_nation:
+		return 600.0f;
+	default:
+		return 1.0f;
+	}
+}
+
+struct clause_rank {
+	uint16_t* start = nullptr;
+	int32_t size = 0;
+	float cost = 0.0f;
+	float rank = 0.0f;
+};
+
+bool range_holds_key(std::vector<int32_t> const& key_offsets, int32_t from, int32_t to) {
+	auto it = std::lower_bound(key_offsets.begin(), key_offsets.end(), from);
+	return it != key_offsets.end() && *it < to;
+}
+
+// reorders the members of every scope below (and including) tval; returns the estimated cost of evaluating tval
+float reorder_clauses(sys::state& state, uint16_t* tval, std::vector<int32_t> const& key_offsets, std::vector<uint16_t>& scratch) {
+	if((tval[0] & code_mask) < first_scope_code)
+		return 1.0f;
+
+	auto const source_size = 1 + get_trigger_scope_payload_size(tval);
+	auto const first_member = tval + 2 + trigger_scope_data_payload(tval[0]);
+	bool const disjunctive = (tval[0] & is_disjunctive_scope) != 0;
+
+	std::vector<clause_rank> members;
+	for(auto sub_units_start = first_member; sub_units_start < tval + source_size; ) {
+		auto const size = 1 + get_trigger_payload_size(sub_units_start);
+		auto cost = reorder_clauses(state, sub_units_start, key_offsets, scratch);
+		auto p = std::clamp(state.trigger_clause_statistics.pass_rate(sub_units_start[0]), 0.01f, 0.99f);
+		// testing a clause is only worth its cost in proportion to how often it ends the block early
+		members.push_back(clause_rank{ sub_units_start, size, cost, cost / (disjunctive ? p : 1.0f - p) });
+		sub_units_start += size;
+	}
+
+	float total = 0.0f;
+	for(auto& m : members)
+		total += m.cost;
+
+	auto const base = state.trigger_data.data();
+	// no key may point inside the members, or moving them would change what that key refers to
+	if(members.size() > 1 && !range_holds_key(key_offsets, int32_t(first_member - base), int32_t(tval + source_size - base))) {
+		std::stable_sort(members.begin(), members.end(), [](clause_rank const& a, clause_rank const& b) { return a.rank < b.rank; });
+		scratch.clear();
+		for(auto& m : members)
+			scratch.insert(scratch.end(), m.start, m.start + m.size);
+		std::copy(scratch.begin(), scratch.end(), first_member);
+	}
+
+	return 1.0f + scope_fan_out(tval[0]) * total;
+}
+
+}
+
+void reorder_trigger_clauses(sys::state& state) {
+	if(state.trigger_data_indices.size() <= 1)
+		return;
+
+	std::vector<int32_t> key_offsets(state.trigger_data_indices.begin() + 1, state.trigger_data_indices.end());
+	std::sort(key_offsets.begin(), key_offsets.end());
+	key_offsets.erase(std::unique(key_offsets.begin(), key_offsets.end()), key_offsets.end());
+
+	std::vector<uint16_t> scratch;
+	for(auto start : key_offsets) {
+		// keys may share storage; reordering the same block twice is harmless since the order is deterministic
+		reorder_clauses(state, state.trigger_data.data() + start, key_offsets, scratch);
+	}
+}
+
+script_profile_counters* profile_counters(sys::state& state, dcon::trigger_key k) {
+	if(!state.script_profile.enabled.load(std::memory_order_acquire) || size_t(k.index()) >= state.script_profile.trigger_count)
+		return nullptr;
+	return &state.script_profile.triggers[k.index()];
+}
+script_profile_counters* profile_counters(sys::state& state, dcon::effect_key k) {
+	if(!state.script_profile.enabled.load(std::memory_order_acquire) || size_t(k.index()) >= state.script_profile.effect_count)
+		return nullptr;
+	return &state.script_profile.effects[k.index()];
+}
+script_profile_counters* profile_counters(sys::state& state, dcon::value_modifier_key k) {
+	if(!state.script_profile.enabled.load(std::memory_order_acquire) || size_t(k.index()) >= state.script_profile.value_modifier_count)
+		return nullptr;
+	return &state.script_profile.value_modifiers[k.index()];
+}
+
+namespace {
+
+void reset_profile_counters(std::unique_ptr<script_profile_counters[]>& counters, size_t& count, size_t new_count) {
+	// counters are only ever reallocated when the scenario changed size, so a scope still running from an earlier profile
+	// never writes to freed memory
+	if(!counters || count != new_count) {
+		counters = std::make_unique<script_profile_counters[]>(new_count);
+		count = new_count;
+		return;
+	}
+	for(size_t i = 0; i < count; ++i) {
+		counters[i].calls.store(0, std::memory_order_relaxed);
+		counters[i].items.store(0, std::memory_order_relaxed);
+		counters[i].nanoseconds.store(0, std::memory_order_relaxed);
+	}
+}
+
+struct script_profile_line {
+	std::string_view kind;
+	uint32_t index = 0;
+	uint64_t calls = 0;
+	uint64_t items = 0;
+	uint64_t nanoseconds = 0;
+};
+
+// names the events, decisions and other definitions that refer to each key, so that a line of the profile can be traced
+// back to the script that produced it; interned keys can be shared by several definitions
+struct script_profile_sources {
+	std::vector<std::string> triggers;
+	std::vector<std::string> effects;
+	std::vector<std::string> value_modifiers;
+
+	static void add(std::vector<std::string>& v, int32_t index, std::string const& text) {
+		if(index < 0 || size_t(index) >= v.size())
+			return;
+		if(!v[index].empty())
+			v[index] += " | ";
+		v[index] += text;
+	}
+
+	script_profile_sources(sys::state& state) : triggers(state.script_profile.trigger_count), effects(state.script_profile.effect_count), value_modifiers(state.script_profile.value_modifier_count) {
+		auto add_options = [&](std::string const& owner, std::array<sys::event_option, sys::max_event_options> const& options) {
+			for(int32_t i = 0; i < sys::max_event_options; ++i) {
+				if(options[i].effect)
+					add(effects, options[i].effect.index(), owner + " option " + std::to_string(i + 1));
+				if(options[i].ai_chance)
+					add(value_modifiers, options[i].ai_chance.index(), owner + " option " + std::to_string(i + 1) + " ai_chance");
+			}
+		};
+
+		for(auto d : state.world.in_decision) {
+			auto owner = "decision " + text::produce_simple_string(state, d.get_name());
+			if(d.get_potential())
+				add(triggers, d.get_potential().index(), owner + " potential");
+			if(d.get_allow())
+				add(triggers, d.get_allow().index(), owner + " allow");
+			if(d.get_effect())
+				add(effects, d.get_effect().index(), owner + " effect");
+			if(d.get_ai_will_do())
+				add(value_modifiers, d.get_ai_will_do().index(), owner + " ai_will_do");
+		}
+		for(auto e : state.world.in_free_national_event) {
+			auto owner = "country_event " + std::to_string(e.get_legacy_id()) + " (" + text::produce_simple_string(state, e.get_name()) + ")";
+			if(e.get_trigger())
+				add(triggers, e.get_trigger().index(), owner + " trigger");
+			if(e.get_mtth())
+				add(value_modifiers, e.get_mtth().index(), owner + " mean_time_to_happen");
+			if(e.get_immediate_effect())
+				add(effects, e.get_immediate_effect().index(), owner + " immediate");
+			add_options(owner, e.get_options());
+		}
+		for(auto e : state.world.in_free_provincial_event) {
+			auto owner = "province_event (" + text::produce_simple_string(state, e.get_name()) + ")";
+			if(e.get_trigger())
+				add(triggers, e.get_trigger().index(), owner + " trigger");
+			if(e.get_mtth())
+				add(value_modifiers, e.get_mtth().index(), owner + " mean_time_to_happen");
+			if(e.get_immediate_effect())
+				add(effects, e.get_immediate_effect().index(), owner + " immediate");
+			add_options(owner, e.get_options());
+		}
+		for(auto e : state.world.in_national_event) {
+			auto owner = "country_event (" + text::produce_simple_string(state, e.get_name()) + ")";
+			if(e.get_immediate_effect())
+				add(effects, e.get_immediate_effect().index(), owner + " immediate");
+			add_options(owner, e.get_options());
+		}
+		for(auto e : state.world.in_provincial_event) {
+			auto owner = "province_event (" + text::produce_simple_string(state, e.get_name()) + ")";
+			if(e.get_immediate_effect())
+				add(effects, e.get_immediate_effect().index(), owner + " immediate");
+			add_options(owner, e.get_options());
+		}
+		for(auto f : state.world.in_national_focus) {
+			if(f.get_limit())
+				add(triggers, f.get_limit().index(), "national_focus " + text::produce_simple_string(state, f.get_name()) + " limit");
+		}
+		for(auto t : state.world.in_stored_trigger) {
+			if(t.get_function())
+				add(triggers, t.get_function().index(), "scripted_trigger " + text::produce_simple_string(state, t.get_name()));
+		}
+	}
+
+	std::string const& source_of(script_profile_line const& l) const {
+		static std::string const none;
+		auto& v = l.kind == "trigger" ? triggers : (l.kind == "effect" ? effects : value_modifiers);
+		return l.index < v.size() ? v[l.index] : none;
+	}
+};
+
+std::vector<script_profile_line> collect_script_profile(sys::state& state) {
+	std::vector<script_profile_line> lines;
+	auto gather = [&](std::string_view kind, std::unique_ptr<script_profile_counters[]> const& counters, size_t count) {
+		for(size_t i = 0; i < count; ++i) {
+			auto calls = counters[i].calls.load(std::memory_order_relaxed);
+			if(calls == 0)
+				continue;
+			lines.push_back(script_profile_line{ kind, uint32_t(i), calls, counters[i].items.load(std::memory_order_relaxed), counters[i].nanoseconds.load(std::memory_order_relaxed) });
+		}
+	};
+	gather("trigger", state.script_profile.triggers, state.script_profile.trigger_count);
+	gather("effect", state.script_profile.effects, state.script_profile.effect_count);
+	gather("value_modifier", state.script_profile.value_modifiers, state.script_profile.value_modifier_count);
+	std::sort(lines.begin(), lines.end(), [](script_profile_line const& a, script_profile_line const& b) { return a.nanoseconds > b.nanoseconds; });
+	return lines;
+}
+
+std::string csv_escape(std::string const& s) {
+	std::string result = "\"";
+	for(auto c : s) {
+		if(c == '"')
+			result += '"';
+		result += c;
+	}
+	result += '"';
+	return result;
+}
+
+}
+
+void start_script_profile(sys::state& state) {
+	state.script_profile.enabled.store(false, std::memory_order_release);
+	reset_profile_counters(state.script_profile.triggers, state.script_profile.trigger_count, state.trigger_data_indices.empty() ? 0 : state.trigger_data_indices.size() - 1);
+	reset_profile_counters(state.script_profile.effects, state.script_profile.effect_count, state.effect_data_indices.empty() ? 0 : state.effect_data_indices.size() - 1);
+	reset_profile_counters(state.script_profile.value_modifiers, state.script_profile.value_modifier_count, state.value_modifiers.size());
+	state.script_profile.enabled.store(true, std::memory_order_release);
+}
+
+void stop_script_profile(sys::state& state) {
+	state.script_profile.enabled.store(false, std::memory_order_release);
+	if(!state.script_profile.triggers)
+		return;
+
+	auto lines = collect_script_profile(state);
+	script_profile_sources sources(state);
+
+	std::string csv = "kind,key,calls,lanes per call,total ms,average us,source\n";
+	for(auto& l : lines) {
+		csv += std::string(l.kind) + "," + std::to_string(l.index) + "," + std::to_string(l.calls) + ","
+			+ std::to_string(double(l.items) / double(l.calls)) + "," + std::to_string(double(l.nanoseconds) / 1'000'000.0) + ","
+			+ std::to_string(double(l.nanoseconds) / 1'000.0 / double(l.calls)) + "," + csv_escape(sources.source_of(l)) + "\n";
+	}
+	auto data_dumps_directory = simple_fs::get_or_create_data_dumps_directory();
+	simple_fs::write_file(data_dumps_directory, NATIVE("script_profile.csv"), csv.c_str(), uint32_t(csv.size()));
+}
+
+std::string script_profile_summary(sys::state& state, uint32_t max_lines) {
+	if(!state.script_profile.triggers)
+		return std::string{ };
+
+	auto lines = collect_script_profile(state);
+	script_profile_sources sources(state);
+
+	std::string result;
+	for(uint32_t i = 0; i < max_lines && i < lines.size(); ++i) {
+		auto& l = lines[i];
+		auto& src = sources.source_of(l);
+		result += std::string(l.kind) + " " + std::to_string(l.index) + ": " + std::to_string(l.nanoseconds / 1'000'000) + " ms, "
+			+ std::to_string(l.calls) + " calls" + (src.empty() ? std::string{ } : " - " + src) + "\n";
+	}
+	return result;
+}
 
 } // namespace trigger
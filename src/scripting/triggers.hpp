@@ -1,11 +1,153 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
 #include "script_constants.hpp"
 #include "dcon_generated.hpp"
 #include "container_types.hpp"
+#include "unordered_dense.h"
 
 namespace trigger {
 
+inline constexpr uint32_t clause_statistics_size = uint32_t(first_invalid_code) * 8;
+
+// how often the members of and / or blocks pass, keyed by trigger code and comparison
+// only collected while enabled from the console (trigger-clause-stats); read by reorder_trigger_clauses
+struct clause_statistics {
+	std::array<std::atomic<uint64_t>, clause_statistics_size> evaluated;
+	std::array<std::atomic<uint64_t>, clause_statistics_size> passed;
+	std::atomic<bool> collecting = false;
+
+	static uint32_t index_of(uint16_t code) {
+		return uint32_t(code & code_mask) + uint32_t(first_invalid_code) * uint32_t((code & association_mask) >> 12);
+	}
+	void record(uint16_t code, uint32_t lanes, uint32_t lanes_passed) {
+		if((code & code_mask) >= first_invalid_code)
+			return;
+		evaluated[index_of(code)].fetch_add(lanes, std::memory_order_relaxed);
+		passed[index_of(code)].fetch_add(lanes_passed, std::memory_order_relaxed);
+	}
+	float pass_rate(uint16_t code) const { // 0.5 when there is not enough data
+		if((code & code_mask) >= first_invalid_code)
+			return 0.5f;
+		auto e = evaluated[index_of(code)].load(std::memory_order_acquire);
+		if(e < 64)
+			return 0.5f;
+		return float(passed[index_of(code)].load(std::memory_order_acquire)) / float(e);
+	}
+	void reset() { // release so that a reader on another thread never sees a cleared count next to a stale one
+		for(auto& v : passed)
+			v.store(0, std::memory_order_release);
+		for(auto& v : evaluated)
+			v.store(0, std::memory_order_release);
+	}
+};
+
+void save_clause_statistics(sys::state& state);
+void load_clause_statistics(sys::state& state);
+// rewrites and / or blocks in trigger_data so that cheap and selective clauses are tested first; results are unchanged
+void reorder_trigger_clauses(sys::state& state);
+
+struct script_profile_counters {
+	std::atomic<uint64_t> calls = 0;
+	std::atomic<uint64_t> items = 0; // objects evaluated; items / calls is the average number of occupied simd lanes (a whole contiguous block counts as full)
+	std::atomic<uint64_t> nanoseconds = 0; // includes nested triggers and effects
+};
+
+// per key counters for triggers, effects and value modifiers; only filled while enabled from the console (script-profile)
+struct script_profiler {
+	std::unique_ptr<script_profile_counters[]> triggers;
+	std::unique_ptr<script_profile_counters[]> effects;
+	std::unique_ptr<script_profile_counters[]> value_modifiers;
+	size_t trigger_count = 0;
+	size_t effect_count = 0;
+	size_t value_modifier_count = 0;
+	std::atomic<bool> enabled = false; // stored with release after the counters are reset, loaded with acquire
+};
+
+class script_profile_scope {
+	script_profile_counters* counters = nullptr;
+	uint32_t items = 0;
+	std::chrono::steady_clock::time_point start;
+public:
+	script_profile_scope(script_profile_counters* c, uint32_t items) : counters(c), items(items) {
+		if(counters)
+			start = std::chrono::steady_clock::now();
+	}
+	~script_profile_scope() {
+		if(counters) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			counters->calls.fetch_add(1, std::memory_order_relaxed);
+			counters->items.fetch_add(items, std::memory_order_relaxed);
+			counters->nanoseconds.fetch_add(uint64_t(elapsed), std::memory_order_relaxed);
+		}
+	}
+	script_profile_scope(script_profile_scope const&) = delete;
+	script_profile_scope& operator=(script_profile_scope const&) = delete;
+};
+
+// these return nullptr while profiling is disabled
+script_profile_counters* profile_counters(sys::state& state, dcon::trigger_key k);
+script_profile_counters* profile_counters(sys::state& state, dcon::effect_key k);
+script_profile_counters* profile_counters(sys::state& state, dcon::value_modifier_key k);
+
+void start_script_profile(sys::state& state);
+void stop_script_profile(sys::state& state); // writes script_profile.csv to the data dumps directory
+std::string script_profile_summary(sys::state& state, uint32_t max_lines); // the most expensive entries, for the console
+
+// results of scalar evaluate(key, ...) calls, reused while a memo_scope is open on the thread that opened it
+// opt-in through define:ALICE_TRIGGER_MEMO_BUDGET, the maximum number of results held at once (0 disables the cache)
+struct memo_cache {
+	struct key_type {
+		dcon::trigger_key key;
+		int32_t primary = 0;
+		int32_t this_slot = 0;
+		int32_t from_slot = 0;
+
+		bool operator==(key_type const& o) const noexcept {
+			return key == o.key && primary == o.primary && this_slot == o.this_slot && from_slot == o.from_slot;
+		}
+	};
+	struct key_hash {
+		using is_avalanching = void;
+		auto operator()(key_type const& k) const noexcept -> uint64_t {
+			int32_t data[4] = { int32_t(k.key.index()), k.primary, k.this_slot, k.from_slot };
+			return ankerl::unordered_dense::detail::wyhash::hash(data, sizeof(data));
+		}
+	};
+
+	ankerl::unordered_dense::map<key_type, bool, key_hash> results;
+	std::vector<uint8_t> classification; // per trigger key: 0 = not yet examined, 1 = cacheable, 2 = reads the date
+	std::atomic<bool> active = false;
+	std::thread::id owner;
+	uint32_t depth = 0;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t invalidations = 0;
+};
+
+/*
+The world must not change while a memo_scope is open, except through effects (which drop the cached results). The cache is
+emptied when the outermost scope closes, so no result outlives the tick, or even the read-only stretch of it, that produced it.
+Only the opening thread uses the cache; evaluations made from worker threads in the meantime bypass it.
+*/
+class memo_scope {
+	sys::state& state;
+	bool opened = false;
+public:
+	explicit memo_scope(sys::state& state);
+	~memo_scope();
+	memo_scope(memo_scope const&) = delete;
+	memo_scope& operator=(memo_scope const&) = delete;
+};
+
+void invalidate_memo(sys::state& state);
+std::string memo_summary(sys::state& state); // hit and miss counters, for the console
+
 float read_float_from_payload(uint16_t const* data);
 int32_t read_int32_t_from_payload(uint16_t const* data);
 
@@ -167,11 +309,15 @@ inline ve::partial_contiguous_tags<dcon::rebel_faction_id> to_rebel(ve::partial_
 
 float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
 ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
+ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+ve::fp_vector evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot);
 
 ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
+ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 float evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
 ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+ve::fp_vector evaluate_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::partial_contiguous_tags<int32_t> primary, ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot);
 
 ve::fp_vector evaluate_purely_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, ve::contiguous_tags<int32_t> primary, ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 float evaluate_purely_additive_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
@@ -184,6 +330,8 @@ ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguou
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous_tags<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
+ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::partial_contiguous_tags<int32_t> primary,
+		ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::tagged_vector<int32_t> primary,
 		ve::tagged_vector<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::tagged_vector<int32_t> primary,
@@ -192,4 +340,6 @@ ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguou
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous_tags<int32_t> primary,
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::partial_contiguous_tags<int32_t> primary,
+		ve::partial_contiguous_tags<int32_t> this_slot, int32_t from_slot);
 } // namespace trigger
@@ -397,10 +397,7 @@ void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 	state.reset_locale_pool();
 
 	auto fb_name = state.world.locale_get_fallback(l);
-	if(fb_name.size() > 0) {
-		std::string_view fb_name_sv((char const*)fb_name.begin(), fb_name.size());
-		state.load_locale_strings(fb_name_sv);
-	}
+	std::string_view fb_name_sv((char const*)fb_name.begin(), fb_name.size());
 
 	UErrorCode errorCode = U_ZERO_ERROR;
 	UBreakIterator* lb_it = ubrk_open(UBreakIteratorType::UBRK_LINE, lang_str.c_str(), nullptr, 0, &errorCode);
@@ -417,7 +414,14 @@ void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 
 	ubrk_close(lb_it);
 
-	state.load_locale_strings(localename_sv);
+	auto sources = state.locale_sources_checksum(fb_name_sv, localename_sv);
+	if(!state.load_locale_pack(localename_sv, sources)) {
+		if(fb_name_sv.size() > 0) {
+			state.load_locale_strings(fb_name_sv);
+		}
+		state.load_locale_strings(localename_sv);
+		state.save_locale_pack(localename_sv, sources);
+	}
 }
 
 font& font_manager::get_font(sys::state& state, font_selection s) {
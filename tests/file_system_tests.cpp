@@ -1,6 +1,8 @@
 #include "catch2/catch.hpp"
 #include "simple_fs.hpp"
 #include <algorithm>
+#include <map>
+#include <regex>
 
 TEST_CASE("File system reading", "[file_system]") {
 	SECTION("single root") {
@@ -130,6 +132,157 @@ TEST_CASE("File system directories", "[file_system]") {
 	}
 }
 
+TEST_CASE("File system index", "[file_system]") {
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE_M(PROJECT_ROOT));
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests"));
+
+	auto root_dir = get_root(fs);
+	auto glew_dir = open_directory(open_directory(root_dir, NATIVE("dependencies")), NATIVE("glew"));
+
+	auto scanned_txt_files = list_files(root_dir, NATIVE(".txt"));
+	auto scanned_glew_files = list_files(glew_dir, NATIVE(""));
+	auto scanned_main = peek_file(root_dir, NATIVE("test_main.cpp"));
+
+	build_index(fs);
+
+	auto indexed_txt_files = list_files(root_dir, NATIVE(".txt"));
+	REQUIRE(indexed_txt_files.size() == scanned_txt_files.size());
+	for(size_t i = 0; i < indexed_txt_files.size(); ++i) {
+		REQUIRE(get_full_name(indexed_txt_files[i]) == get_full_name(scanned_txt_files[i]));
+	}
+	auto indexed_glew_files = list_files(glew_dir, NATIVE(""));
+	REQUIRE(indexed_glew_files.size() == scanned_glew_files.size());
+	REQUIRE(something_is_named(indexed_glew_files, NATIVE("CMakeLists.txt")) == true);
+
+	auto indexed_main = peek_file(root_dir, NATIVE("test_main.cpp"));
+	REQUIRE(bool(indexed_main) == true);
+	REQUIRE(get_full_name(*indexed_main) == get_full_name(*scanned_main));
+	REQUIRE(bool(peek_file(root_dir, NATIVE("&*^*&()^"))) == false);
+	REQUIRE(bool(peek_file(root_dir, NATIVE("cmakelists.txt"))) == true);
+
+	auto lists = open_file(root_dir, NATIVE("CMakeLists.txt")); // the tests root is searched first
+	REQUIRE(bool(lists) == true);
+	auto content = view_contents(*lists);
+	REQUIRE(content.file_size > 5);
+	REQUIRE(content.data[0] == '#');
+	REQUIRE(content.data[1] == '9');
+
+	auto glewmake = open_file(glew_dir, NATIVE("CMakeLists.txt"));
+	REQUIRE(bool(glewmake) == true);
+	REQUIRE(view_contents(*glewmake).data[1] == 'G');
+
+	add_ignore_path(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests") NATIVE_SEP); // drops the index, so this is a scan again
+	auto unshadowed = open_file(root_dir, NATIVE("CMakeLists.txt"));
+	REQUIRE(bool(unshadowed) == true);
+	REQUIRE(view_contents(*unshadowed).data[1] != '9');
+	REQUIRE(bool(peek_file(root_dir, NATIVE("test_main.cpp"))) == false);
+
+	build_index(fs); // the index has to leave out the ignored root as well
+	auto indexed_unshadowed = open_file(root_dir, NATIVE("CMakeLists.txt"));
+	REQUIRE(bool(indexed_unshadowed) == true);
+	REQUIRE(view_contents(*indexed_unshadowed).data[1] != '9');
+	REQUIRE(get_full_name(*indexed_unshadowed) == get_full_name(*unshadowed));
+	REQUIRE(bool(peek_file(root_dir, NATIVE("test_main.cpp"))) == false);
+	REQUIRE(bool(open_file(root_dir, NATIVE("test_main.cpp"))) == false);
+	REQUIRE(something_is_named(list_files(root_dir, NATIVE(".cpp")), NATIVE("test_main.cpp")) == false);
+	native_string const ignored = NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests") NATIVE_SEP;
+	auto indexed_lists = list_files(root_dir, NATIVE(".txt"));
+	REQUIRE(std::count_if(indexed_lists.begin(), indexed_lists.end(), [&](simple_fs::unopened_file const& f) {
+		return get_full_name(f).starts_with(ignored);
+	}) == 0);
+}
+
+TEST_CASE("scenario input manifest", "[file_system]") {
+	std::vector<native_string> const whole_root{ native_string{} };
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("src") NATIVE_SEP NATIVE("filesystem"));
+	auto base = sys::make_scenario_input_manifest(fs, {}, whole_root);
+	REQUIRE(sys::changed_scenario_inputs(base.data(), base.size(), sys::make_scenario_input_manifest(fs, {}, whole_root)).empty());
+	REQUIRE(sys::make_scenario_input_manifest(fs, base, whole_root) == base);
+
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests"));
+	auto extended = sys::make_scenario_input_manifest(fs, base, whole_root);
+	auto changed = sys::changed_scenario_inputs(base.data(), base.size(), extended);
+	REQUIRE(std::find(changed.begin(), changed.end(), std::string("file_system_tests.cpp")) != changed.end());
+	REQUIRE(std::find(changed.begin(), changed.end(), std::string("simple_fs.hpp")) == changed.end());
+
+	auto unreadable = sys::changed_scenario_inputs(base.data(), base.size() - 1, extended);
+	REQUIRE(unreadable.size() == size_t(1));
+	REQUIRE(unreadable[0].empty());
+
+	// a file with an unchanged size and write time is not read again: a tampered hash is carried over as it is
+	simple_fs::file_system base_fs;
+	add_root(base_fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("src") NATIVE_SEP NATIVE("filesystem"));
+	auto tampered = base;
+	tampered[tampered.size() - 1] ^= 0x01;
+	auto carried = sys::make_scenario_input_manifest(base_fs, tampered, whole_root);
+	REQUIRE(sys::changed_scenario_inputs(tampered.data(), tampered.size(), carried).empty());
+
+	// only the listed directories are collected
+	simple_fs::file_system src_fs;
+	add_root(src_fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("src"));
+	auto filesystem_only = sys::make_scenario_input_manifest(src_fs, {}, std::vector<native_string>{ NATIVE("filesystem") });
+	auto compared = sys::changed_scenario_inputs(filesystem_only.data(), filesystem_only.size(), sys::make_scenario_input_manifest(src_fs, filesystem_only, whole_root));
+	REQUIRE(std::find(compared.begin(), compared.end(), std::string("main.cpp")) != compared.end());
+	REQUIRE(std::find(compared.begin(), compared.end(), std::string("filesystem/simple_fs.hpp")) == compared.end());
+}
+
+TEST_CASE("scenario input directories", "[file_system]") {
+	// every directory the scenario build opens, found by following the open_directory chains in its sources, has to be
+	// collected by the manifest; otherwise an edit to a file in it would not rebuild the scenario
+	std::vector<std::string> const not_parsed{ "gfx/flags" }; // only checked for missing files, with a warning
+
+	std::vector<std::string> listed;
+	for(auto& d : sys::scenario_input_directories())
+		listed.push_back(simple_fs::native_to_utf8(d));
+	auto is_covered = [&](std::string const& path) {
+		for(auto& d : listed) {
+			if(path == d || path.starts_with(d + "/") || d.starts_with(path + "/")) // inside a listed directory, or on the way to one
+				return true;
+		}
+		return std::find(not_parsed.begin(), not_parsed.end(), path) != not_parsed.end();
+	};
+
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("src"));
+	auto root = get_root(fs);
+	std::vector<simple_fs::unopened_file> build_sources = list_files(open_directory(root, NATIVE("parsing")), NATIVE(".cpp"));
+	std::pair<native_char const*, native_char const*> const other_sources[] = {
+		{ NATIVE("gamestate"), NATIVE("system_state.cpp") }, { NATIVE("gui"), NATIVE("gui_graphics.cpp") }, { NATIVE("map"), NATIVE("map_data_loading.cpp") } };
+	for(auto& [dir, name] : other_sources) {
+		auto f = peek_file(open_directory(root, dir), name);
+		REQUIRE(bool(f) == true);
+		build_sources.push_back(*f);
+	}
+	std::regex const open_call(R"(auto\s+(\w+)\s*=\s*(?:simple_fs::)?open_directory\(\s*(\w+)\s*,\s*NATIVE\("([^"]*)"\)\s*\))");
+	size_t opened = 0;
+	for(auto& source : build_sources) {
+		auto file = open_file(source);
+		REQUIRE(bool(file) == true);
+		auto content = view_contents(*file);
+		std::string text(content.data, content.file_size);
+		std::map<std::string, std::string> paths; // variable -> directory it holds
+		for(auto it = std::sregex_iterator(text.begin(), text.end(), open_call); it != std::sregex_iterator(); ++it) {
+			auto variable = (*it)[1].str();
+			auto parent = (*it)[2].str();
+			std::string path;
+			if(parent == "root" || parent == "rt") {
+				path = (*it)[3].str();
+			} else if(auto p = paths.find(parent); p != paths.end()) {
+				path = p->second + "/" + (*it)[3].str();
+			} else {
+				continue;
+			}
+			paths.insert_or_assign(variable, path);
+			++opened;
+			INFO(simple_fs::native_to_utf8(get_file_name(source)) << " opens " << path);
+			REQUIRE(is_covered(path));
+		}
+	}
+	REQUIRE(opened > size_t(20));
+}
+
 TEST_CASE("writing special files", "[file_system]") {
 	auto saves_dir = simple_fs::get_or_create_scenario_directory();
 	write_file(saves_dir, NATIVE("fs_test_generated.hpp"), "// nothing to see here", uint32_t(strlen("// nothing to see here")));
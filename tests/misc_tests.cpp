@@ -225,3 +225,61 @@ TEST_CASE("cyto payload tests", "[misc_tests]") {
 		REQUIRE(any_cast<void *>(vp_payload) == (void *)nullptr);
 	}
 }
+
+TEST_CASE("texture decoding", "[misc_tests]") {
+	// 2x1 uncompressed, top-left origin, 32 bit tga; pixels are stored as bgra
+	uint8_t const tga[] = {
+		0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 0, 32, 0x28,
+		1, 2, 3, 4,
+		10, 20, 30, 40
+	};
+	auto image = ogl::decode_texture(simple_fs::file_contents{ reinterpret_cast<char const*>(tga), uint32_t(sizeof(tga)) });
+	REQUIRE(image.data != nullptr);
+	REQUIRE(image.size_x == 2);
+	REQUIRE(image.size_y == 1);
+	REQUIRE(image.data[0] == 3);
+	REQUIRE(image.data[1] == 2);
+	REQUIRE(image.data[2] == 1);
+	REQUIRE(image.data[3] == 4);
+	REQUIRE(image.data[4] == 30);
+	REQUIRE(image.data[7] == 40);
+	ogl::free_decoded_texture(image);
+	REQUIRE(image.data == nullptr);
+
+	char const garbage[] = "not an image";
+	auto bad = ogl::decode_texture(simple_fs::file_contents{ garbage, uint32_t(sizeof(garbage)) });
+	REQUIRE(bad.data == nullptr);
+	REQUIRE(bad.size_x == 0);
+	REQUIRE(bad.size_y == 0);
+}
+
+TEST_CASE("locale pack round trip", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	state->reset_locale_pool();
+
+	auto add_entry = [&](std::string_view key, std::string_view value) {
+		state->locale_key_to_text_sequence.insert_or_assign(state->add_key_utf8(key), state->add_locale_data_utf8(value));
+	};
+	add_entry("first_key", "first value");
+	add_entry("second_key", "stale value");
+	add_entry("second_key", "second value"); // overridden, as a later csv file would
+	add_entry("empty_key", "");
+
+	sys::checksum_key sources;
+	sources.key[0] = 1;
+	auto pack = state->write_locale_pack(sources);
+
+	std::unique_ptr<sys::state> loaded = std::make_unique<sys::state>();
+	loaded->reset_locale_pool();
+
+	sys::checksum_key other_sources;
+	REQUIRE(loaded->read_locale_pack(pack.data(), uint32_t(pack.size()), other_sources) == false);
+	REQUIRE(loaded->read_locale_pack(pack.data(), uint32_t(pack.size() - 1), sources) == false);
+	REQUIRE(loaded->read_locale_pack(pack.data(), uint32_t(pack.size()), sources) == true);
+
+	REQUIRE(loaded->locale_key_to_text_sequence.size() == size_t(3));
+	REQUIRE(loaded->locale_string_view(loaded->locale_key_to_text_sequence.find(std::string_view("FIRST_KEY"))->second) == "first value");
+	REQUIRE(loaded->locale_string_view(loaded->locale_key_to_text_sequence.find(std::string_view("second_key"))->second) == "second value");
+	REQUIRE(loaded->locale_string_view(loaded->locale_key_to_text_sequence.find(std::string_view("empty_key"))->second) == "");
+	REQUIRE(loaded->locale_text_data.size() < state->locale_text_data.size()); // the overridden string was dropped
+}
@@ -504,3 +504,106 @@ TEST_CASE("Floating point parser tests", "[parsers]") {
 		REQUIRE(val == -1.5);
 	}
 }
+
+TEST_CASE("Numeric fast path matches the general parser", "[parsers]") {
+	// a trailing space keeps the same digits but sends the text through the general loop, which must agree bit for bit
+	std::vector<std::string> const samples = { "0", "7", "-7", "+7", "1.", ".5", "-", "00012", "0.1", "3.14159", "-0.000001",
+		"12345678", "123456789.25", "0.123456789012", "123456789012345678", "12345678.12345678", "1234567890123.45678",
+		"99999999999999999.9", "1.2.3", "4294967296", "-2147483648" };
+	for(auto& s : samples) {
+		auto padded = s + " ";
+		float fast_f = 0.0f;
+		float slow_f = 0.0f;
+		REQUIRE(parsers::float_from_chars(s.data(), s.data() + s.length(), fast_f));
+		REQUIRE(parsers::float_from_chars(padded.data(), padded.data() + padded.length(), slow_f));
+		REQUIRE(std::memcmp(&fast_f, &slow_f, sizeof(float)) == 0);
+
+		double fast_d = 0.0;
+		double slow_d = 0.0;
+		REQUIRE(parsers::double_from_chars(s.data(), s.data() + s.length(), fast_d));
+		REQUIRE(parsers::double_from_chars(padded.data(), padded.data() + padded.length(), slow_d));
+		REQUIRE(std::memcmp(&fast_d, &slow_d, sizeof(double)) == 0);
+
+		int32_t fast_i = 0;
+		int32_t std_i = 0;
+		auto result = std::from_chars(s.data(), s.data() + s.length(), std_i);
+		if(parsers::int_from_chars(s.data(), s.data() + s.length(), fast_i)) {
+			REQUIRE(result.ec == std::errc{});
+			REQUIRE(result.ptr == s.data() + s.length());
+			REQUIRE(fast_i == std_i);
+		}
+	}
+	parsers::error_handler err("");
+	REQUIRE(parsers::parse_int("-2147483648", 0, err) == std::numeric_limits<int32_t>::min());
+	REQUIRE(parsers::parse_int("123456789", 0, err) == 123456789);
+	REQUIRE(err.accumulated_errors.empty());
+}
+
+TEST_CASE("Numeric parsing of pop history", "[.][parsers][benchmark]") {
+	// needs the game files in the working directory, like the scenario tests; run with [benchmark]
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE("."));
+	auto pops = open_directory(open_directory(get_root(fs), NATIVE("history")), NATIVE("pops"));
+
+	std::vector<std::string_view> numbers;
+	std::vector<simple_fs::file> files;
+	for(auto& date_dir : list_subdirectories(pops)) {
+		for(auto& f : list_files(date_dir, NATIVE(".txt"))) {
+			if(auto of = open_file(f); of)
+				files.push_back(std::move(*of));
+		}
+	}
+	for(auto& f : files) {
+		auto content = view_contents(f);
+		parsers::token_generator gen(content.data, content.data + content.file_size);
+		while(!gen.at_end()) {
+			auto t = gen.get();
+			if(t.type == parsers::token_type::identifier && !t.content.empty() && (isdigit(t.content[0]) || t.content[0] == '-'))
+				numbers.push_back(t.content);
+		}
+	}
+	if(numbers.empty())
+		return;
+	// a trailing space keeps the fast path from matching, so these time the general loop the fast path falls back to
+	std::vector<std::string> padded;
+	padded.reserve(numbers.size());
+	for(auto n : numbers)
+		padded.push_back(std::string(n) + " ");
+
+	BENCHMARK("float_from_chars") {
+		float sum = 0.0f;
+		for(auto n : numbers) {
+			float v = 0.0f;
+			parsers::float_from_chars(n.data(), n.data() + n.length(), v);
+			sum += v;
+		}
+		return sum;
+	};
+	BENCHMARK("float_from_chars, general loop") {
+		float sum = 0.0f;
+		for(auto& n : padded) {
+			float v = 0.0f;
+			parsers::float_from_chars(n.data(), n.data() + n.length(), v);
+			sum += v;
+		}
+		return sum;
+	};
+	BENCHMARK("int_from_chars") {
+		int64_t sum = 0;
+		for(auto n : numbers) {
+			int32_t v = 0;
+			if(parsers::int_from_chars(n.data(), n.data() + n.length(), v))
+				sum += v;
+		}
+		return sum;
+	};
+	BENCHMARK("std::from_chars") { // what parse_int falls back to
+		int64_t sum = 0;
+		for(auto n : numbers) {
+			int32_t v = 0;
+			if(std::from_chars(n.data(), n.data() + n.length(), v).ec == std::errc{})
+				sum += v;
+		}
+		return sum;
+	};
+}
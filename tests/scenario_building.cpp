@@ -1383,6 +1383,31 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 	// Ensure the filesystem state is properly loaded back
 	REQUIRE(simple_fs::extract_state(state->common_fs) == fs_str);
 
+	// the alt demographics are only filled on the first tick; copying the main store gives exactly what a full regeneration
+	// of the alt store from the same pops does, since both sum in the same order
+	{
+		REQUIRE(state->alt_demographics_out_of_date == true);
+		demographics::regenerate_from_pop_data_full(*state); // debug builds renormalize pop ideologies after fill_unsaved_data regenerates
+		demographics::update_alt_demographics(*state);
+		REQUIRE(state->alt_demographics_out_of_date == false);
+
+		auto alt_store = [&]() {
+			std::vector<float> values;
+			for(uint32_t i = 0; i < demographics::size(*state); ++i) {
+				dcon::demographics_key k{ dcon::demographics_key::value_base_t(i) };
+				for(auto n : state->world.in_nation)
+					values.push_back(n.get_demographics_alt(k));
+				for(auto s : state->world.in_state_instance)
+					values.push_back(s.get_demographics_alt(k));
+				province::for_each_land_province(*state, [&](dcon::province_id p) { values.push_back(state->world.province_get_demographics_alt(p, k)); });
+			}
+			return values;
+		};
+		auto copied = alt_store();
+		demographics::alt_regenerate_from_pop_data_full(*state);
+		REQUIRE(alt_store() == copied);
+	}
+
 	{
 		auto tag = fatten(state->world, context.map_of_ident_names.find(nations::tag_to_int('N', 'E', 'J'))->second);
 		int32_t non_def_count = 0;
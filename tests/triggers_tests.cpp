@@ -840,3 +840,103 @@ TEST_CASE("trigger payload translation", "[trigger_tests]") {
 		REQUIRE(new_d == dcon::nation_id{42});
 	}
 }
+
+TEST_CASE("clause reordering", "[trigger_tests]") {
+	auto ws = load_testing_scenario_file();
+	auto& state = *ws;
+
+	// an and block holding a nested and block and an or block; the or block is also committed as a key of its own, so its
+	// storage is shared and the members of the outer block must stay where they are
+	std::vector<uint16_t> shared_or{ uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope), uint16_t(4),
+		uint16_t(trigger::association_eq | trigger::no_payload | trigger::civilized_nation),
+		uint16_t(trigger::association_eq | trigger::no_payload | trigger::is_greater_power_nation),
+		uint16_t(trigger::association_ne | trigger::no_payload | trigger::war_nation) };
+	std::vector<uint16_t> guarded{ uint16_t(trigger::generic_scope), uint16_t(11),
+		uint16_t(trigger::generic_scope), uint16_t(3),
+		uint16_t(trigger::association_eq | trigger::no_payload | trigger::is_substate),
+		uint16_t(trigger::association_ne | trigger::no_payload | trigger::has_recently_lost_war) };
+	guarded.insert(guarded.end(), shared_or.begin(), shared_or.end());
+	guarded.push_back(uint16_t(trigger::association_ne | trigger::no_payload | trigger::is_vassal));
+	// an and block whose nested or block is the expensive member and should move to the end
+	std::vector<uint16_t> free_block{ uint16_t(trigger::generic_scope), uint16_t(7),
+		uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope), uint16_t(3),
+		uint16_t(trigger::association_ne | trigger::no_payload | trigger::is_greater_power_nation),
+		uint16_t(trigger::association_eq | trigger::no_payload | trigger::is_vassal),
+		uint16_t(trigger::association_eq | trigger::no_payload | trigger::war_nation),
+		uint16_t(trigger::association_ne | trigger::no_payload | trigger::civilized_nation) };
+
+	auto guarded_key = state.commit_trigger_data(guarded);
+	auto shared_key = state.commit_trigger_data(shared_or);
+	auto free_key = state.commit_trigger_data(free_block);
+	auto guarded_start = state.trigger_data_indices[guarded_key.index() + 1];
+	auto shared_start = state.trigger_data_indices[shared_key.index() + 1];
+	auto free_start = state.trigger_data_indices[free_key.index() + 1];
+	REQUIRE(shared_start == guarded_start + 6);
+
+	// every clause gets a pass rate, so that blocks all over the scenario are reordered; the synthetic ones are set explicitly
+	for(uint32_t i = 0; i < trigger::clause_statistics_size; ++i) {
+		state.trigger_clause_statistics.evaluated[i].store(1000, std::memory_order_relaxed);
+		state.trigger_clause_statistics.passed[i].store((uint64_t(i) * 7919) % 1000, std::memory_order_relaxed);
+	}
+	auto seed = [&](uint16_t code, uint64_t passed) {
+		state.trigger_clause_statistics.passed[trigger::clause_statistics::index_of(code)].store(passed, std::memory_order_relaxed);
+	};
+	seed(uint16_t(trigger::association_eq | trigger::civilized_nation), 200);
+	seed(uint16_t(trigger::association_eq | trigger::is_greater_power_nation), 50);
+	seed(uint16_t(trigger::association_ne | trigger::war_nation), 900);
+	seed(uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope), 500);
+	seed(uint16_t(trigger::association_eq | trigger::war_nation), 500);
+	seed(uint16_t(trigger::association_ne | trigger::civilized_nation), 100);
+
+	auto evaluate_all = [&]() {
+		std::vector<bool> results;
+		auto each_live_nation = [&](auto&& f) {
+			for(auto n : state.world.in_nation) {
+				if(n.get_owned_province_count() != 0)
+					f(n.id);
+			}
+		};
+		for(auto k : { guarded_key, shared_key, free_key }) {
+			each_live_nation([&](dcon::nation_id n) { results.push_back(trigger::evaluate(state, k, trigger::to_generic(n), trigger::to_generic(n), 0)); });
+		}
+		for(auto d : state.world.in_decision) {
+			for(auto k : { d.get_potential(), d.get_allow() }) {
+				if(k)
+					each_live_nation([&](dcon::nation_id n) { results.push_back(trigger::evaluate(state, k, trigger::to_generic(n), trigger::to_generic(n), 0)); });
+			}
+		}
+		for(auto e : state.world.in_free_national_event) {
+			if(auto k = e.get_trigger(); k)
+				each_live_nation([&](dcon::nation_id n) { results.push_back(trigger::evaluate(state, k, trigger::to_generic(n), trigger::to_generic(n), 0)); });
+		}
+		for(auto e : state.world.in_free_provincial_event) {
+			if(auto k = e.get_trigger(); k) {
+				for(auto p : state.world.in_province) {
+					if(p.get_nation_from_province_ownership())
+						results.push_back(trigger::evaluate(state, k, trigger::to_generic(p.id), trigger::to_generic(p.id), 0));
+				}
+			}
+		}
+		return results;
+	};
+
+	auto before = evaluate_all();
+	auto data_before = state.trigger_data;
+	trigger::reorder_trigger_clauses(state);
+	REQUIRE(state.trigger_data.size() == data_before.size());
+	REQUIRE(state.trigger_data != data_before);
+
+	// the members of the guarded block keep their places, while the blocks below it are still reordered
+	REQUIRE(std::equal(guarded.begin(), guarded.begin() + 4, state.trigger_data.begin() + guarded_start));
+	REQUIRE(state.trigger_data[shared_start] == shared_or[0]);
+	REQUIRE(state.trigger_data[guarded_start + 11] == guarded[11]);
+	REQUIRE(state.trigger_data[shared_start + 2] == uint16_t(trigger::association_ne | trigger::no_payload | trigger::war_nation));
+	REQUIRE(state.trigger_data[shared_start + 3] == uint16_t(trigger::association_eq | trigger::no_payload | trigger::civilized_nation));
+	// the unguarded block tests its cheap, selective clause first and its nested or block last
+	REQUIRE(state.trigger_data[free_start + 2] == uint16_t(trigger::association_ne | trigger::no_payload | trigger::civilized_nation));
+	REQUIRE(state.trigger_data[free_start + 4] == uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope));
+
+	auto after = evaluate_all();
+	REQUIRE(before.size() == after.size());
+	REQUIRE(before == after);
+}